@@ -15,11 +15,20 @@
 #define LITTLEFS_DIR_ASSETS  "/assets"
 
 // 설정 파일 경로
-#define LITTLEFS_CONFIG_FILE      "/config/device.json"
-#define LITTLEFS_CONFIG_TEMP_FILE "/config/device.tmp"
+#define LITTLEFS_CONFIG_SLOT_A_FILE "/config/slot_a.cfg"  // A/B 슬롯 (세대 번호 + CRC)
+#define LITTLEFS_CONFIG_SLOT_B_FILE "/config/slot_b.cfg"
+#define LITTLEFS_CONFIG_FILE      "/config/device.json"   // 이전 형식 (마이그레이션만)
+#define LITTLEFS_CONFIG_BIN_FILE  "/config/device.mpk"    // 이전 형식 (마이그레이션만)
 
-// 캐시 파일 경로 (key는 파일명으로 사용)
+// 설정 슬롯 payload 형식 (1이면 MessagePack, 0이면 JSON) - 빌드 플래그로 조정 가능
+#ifndef LITTLEFS_CONFIG_MSGPACK
+#define LITTLEFS_CONFIG_MSGPACK 1
+#endif
+
+// 캐시 파일 경로
 #define LITTLEFS_CACHE_PREFIX     "/cache/"
+#define LITTLEFS_CACHE_SEGMENT_FILE "/cache/segment.log"  // append-only 로그 세그먼트
+#define LITTLEFS_CACHE_COMPACT_FILE "/cache/segment.tmp"  // 컴팩션 임시 파일
 
 // 로그 파일 경로
 #define LITTLEFS_LOG_FILE         "/logs/app.log"
@@ -28,5 +37,38 @@
 #define LITTLEFS_CACHE_DEFAULT_TTL 3600000  // 1시간 (밀리초)
 #define LITTLEFS_MAX_CACHE_SIZE   4096      // 4KB (단일 캐시 항목)
 #define LITTLEFS_MAX_KEY_LEN      32        // 캐시 키 최대 길이
+#define LITTLEFS_CACHE_MAX_ENTRIES 32       // RAM 인덱스 항목 수 (항목당 24바이트)
+#define LITTLEFS_CACHE_COMPACT_THRESHOLD 16384  // 16KB 초과 시 세그먼트 컴팩션
+
+// 캐시 용량 제한 (살아있는 레코드 기준, 초과 시 eviction)
+// 세그먼트 파일은 컴팩션 조건상 max(COMPACT_THRESHOLD, 2 * QUOTA_BYTES)를 넘지 않음
+#define LITTLEFS_CACHE_QUOTA_BYTES   32768                        // 32KB
+#define LITTLEFS_CACHE_QUOTA_ENTRIES LITTLEFS_CACHE_MAX_ENTRIES
+
+// RAM hot tier (LRU, 정적 할당) - 빌드 플래그로 조정 가능, 0이면 비활성
+#ifndef LITTLEFS_CACHE_HOT_BYTES
+#define LITTLEFS_CACHE_HOT_BYTES  1024      // hot tier 전체 예산 (슬롯 헤더 포함)
+#endif
+#ifndef LITTLEFS_CACHE_HOT_SLOT_SIZE
+#define LITTLEFS_CACHE_HOT_SLOT_SIZE 64     // 슬롯당 키+값 최대 크기
+#endif
+
+// write-behind (hot 슬롯에 dirty로 보관 후 일괄 기록) - 0이면 write-through
+// 켜려면 loop에서 CacheMgr.update(), 딥슬립/재시작 전에 CacheMgr.flush() 호출 필요
+#ifndef LITTLEFS_CACHE_WRITE_BEHIND
+#define LITTLEFS_CACHE_WRITE_BEHIND 0
+#endif
+#define LITTLEFS_CACHE_FLUSH_INTERVAL_MS 60000  // 첫 dirty 후 최대 1분 내 기록
+#define LITTLEFS_CACHE_FLUSH_DIRTY_MAX   8      // dirty 슬롯이 이만큼 쌓이면 즉시 기록
+
+// 점진적 만료 정리 (update() 1회당 예산, 만료 인덱스에 기한 도래 항목이 있을 때만 실행)
+#define LITTLEFS_CACHE_SWEEP_ENTRIES     4      // 호출당 최대 삭제 항목 수
+#define LITTLEFS_CACHE_SWEEP_BUDGET_US   2000   // 호출당 최대 시간 (마이크로초)
+
+// stale-while-revalidate (만료 후에도 getStale()로 조회 가능한 기간)
+#define LITTLEFS_CACHE_STALE_WINDOW_MS   86400000  // 24시간 후 삭제
+#define LITTLEFS_CACHE_REVALIDATE_HOOKS  4         // 재검증 훅 최대 수
+#define LITTLEFS_CACHE_REVALIDATE_QUEUE  4         // 재검증 대기 키 수
+#define LITTLEFS_CACHE_REVALIDATE_INTERVAL_MS 60000  // 같은 키 재검증 요청 최소 간격
 
 #endif // ARTHUR_LITTLEFS_H
@@ -1,5 +1,11 @@
 #include "cache_manager.h"
 #include <LittleFS.h>
+#include "arthur_config.h"
+#include "time_manager.h"
+
+// hot tier는 정적 RAM을 차지하므로 힙 안전 마진의 일부만 허용
+static_assert(LITTLEFS_CACHE_HOT_BYTES <= HEAP_SAFETY_MARGIN / 4,
+              "LITTLEFS_CACHE_HOT_BYTES exceeds a quarter of HEAP_SAFETY_MARGIN");
 
 // 전역 인스턴스
 CacheManager CacheMgr;
@@ -9,7 +15,38 @@ CacheManager CacheMgr;
 CacheManager::CacheManager()
     : _mounted(false)
     , _defaultTTL(LITTLEFS_CACHE_DEFAULT_TTL)
+    , _segmentSize(0)
+    , _deadBytes(0)
+    , _liveBytes(0)
+    , _liveCount(0)
+    , _lruTick(0)
+    , _quotaBytes(LITTLEFS_CACHE_QUOTA_BYTES)
+    , _quotaEntries(LITTLEFS_CACHE_QUOTA_ENTRIES)
+    , _evictPolicy(EVICT_LRU)
+    , _evictions(0)
+    , _hotTick(0)
+    , _hotHits(0)
+    , _hotMisses(0)
+    , _writeBehind(LITTLEFS_CACHE_WRITE_BEHIND && HOT_SLOT_COUNT > 0)
+    , _flushDirtyMax(LITTLEFS_CACHE_FLUSH_DIRTY_MAX)
+    , _dirtyCount(0)
+    , _flushInterval(LITTLEFS_CACHE_FLUSH_INTERVAL_MS)
+    , _dirtySince(0)
+    , _clockSynced(false)
+    , _tornTail(false)
+    , _writer(nullptr)
+    , _staleWindow(LITTLEFS_CACHE_STALE_WINDOW_MS)
+    , _hookCount(0)
+    , _revalidatePending(0)
+    , _heapSize(0)
+    , _sweepEntries(LITTLEFS_CACHE_SWEEP_ENTRIES)
+    , _sweepMicros(LITTLEFS_CACHE_SWEEP_BUDGET_US)
 {
+    memset(_index, 0, sizeof(_index));
+    memset(_hot, 0, sizeof(_hot));
+    memset(_heapPos, HEAP_NONE, sizeof(_heapPos));
+    memset(_revalidate, 0, sizeof(_revalidate));
+    memset(&_sweepStats, 0, sizeof(_sweepStats));
 }
 
 bool CacheManager::begin() {
@@ -23,7 +60,21 @@ bool CacheManager::begin() {
         LittleFS.mkdir(LITTLEFS_DIR_CACHE);
     }
 
-    Serial.println(F("[CacheMgr] Cache initialized"));
+    // 이전 포맷 파일 및 중단된 컴팩션 잔여물 정리
+    removeLegacyFiles();
+
+    if (!rebuildIndex()) {
+        Serial.println(F("[CacheMgr] Segment rebuild FAILED"));
+        return false;
+    }
+
+    Serial.print(F("[CacheMgr] Cache initialized ("));
+    Serial.print(count());
+    Serial.print(F(" entries, "));
+    Serial.print((unsigned long)_segmentSize);
+    Serial.print(F(" bytes, hot tier "));
+    Serial.print(HOT_SLOT_COUNT);
+    Serial.println(F(" slots)"));
     return true;
 }
 
@@ -41,262 +92,1695 @@ bool CacheManager::mount() {
     return true;
 }
 
-void CacheManager::getFilePath(const char* key, char* outPath, size_t maxLen) {
-    // 캐시 파일 경로: /cache/{key}
-    snprintf(outPath, maxLen, "%s%s", LITTLEFS_CACHE_PREFIX, key);
+uint32_t CacheManager::hashKey(const char* key) {
+    // FNV-1a 32비트
+    uint32_t hash = 2166136261UL;
+    while (*key) {
+        hash ^= (uint8_t)*key++;
+        hash *= 16777619UL;
+    }
+    // 0은 빈 슬롯 표시로 사용
+    return (hash == 0) ? 1 : hash;
+}
+
+CacheManager::IndexEntry* CacheManager::findEntry(uint32_t hash) {
+    for (int i = 0; i < LITTLEFS_CACHE_MAX_ENTRIES; i++) {
+        if (_index[i].hash == hash) {
+            return &_index[i];
+        }
+    }
+    return nullptr;
+}
+
+CacheManager::IndexEntry* CacheManager::findKey(uint32_t hash, const char* key, size_t keyLen,
+                                                bool& outCollision) {
+    outCollision = false;
+    IndexEntry* entry = findEntry(hash);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+
+    // @MX:NOTE: [해시 충돌] 인덱스에는 해시만 있으므로 저장된 키와 비교
+    // hot 적중이면 RAM 비교, 아니면 레코드 헤더+키만 읽음 (값은 읽지 않음)
+    char storedKey[LITTLEFS_MAX_KEY_LEN];
+    File seg;
+    bool restored = (entry->keyLen == keyLen) && entryKey(*entry, seg, storedKey);
+    if (seg) {
+        seg.close();
+    }
+    if (entry->keyLen != keyLen || (restored && memcmp(storedKey, key, keyLen) != 0)) {
+        outCollision = true;
+        return nullptr;
+    }
+    // 키를 읽지 못한 경우 (플래시 오류)는 같은 키로 간주 - 이후 읽기에서 다시 확인됨
+    return entry;
 }
 
-void CacheManager::getMetaPath(const char* key, char* outPath, size_t maxLen) {
-    // 메타데이터 파일 경로: /cache/.{key}.meta
-    snprintf(outPath, maxLen, "%s.%s.meta", LITTLEFS_CACHE_PREFIX, key);
+CacheManager::IndexEntry* CacheManager::allocEntry() {
+    return findEntry(0);
 }
 
-unsigned long CacheManager::getExpiryTime(unsigned long ttlMillis) {
+uint32_t CacheManager::getExpiryTime(unsigned long ttlMillis, uint8_t& outFlags,
+                                     uint32_t& outWritten) {
     if (ttlMillis == 0) {
         ttlMillis = _defaultTTL;
     }
-    return millis() + ttlMillis;
-}
 
-bool CacheManager::isExpired(const char* key) {
-    char metaPath[LITTLEFS_MAX_PATH_LEN];
-    getMetaPath(key, metaPath, sizeof(metaPath));
+    // @MX:NOTE: [재부팅 생존] 동기화 후에는 Unix 초로 저장, 전에는 millis (재부팅 시 나이 불명)
+    if (clockSynced()) {
+        outFlags = ENTRY_FLAG_WALLCLOCK;
+        outWritten = gTimeManager.getTimestamp();
+        return outWritten + (ttlMillis + 999) / 1000;
+    }
+
+    outFlags = 0;
+    outWritten = millis();
+    return outWritten + ttlMillis;
+}
 
-    File metaFile = LittleFS.open(metaPath, "r");
-    if (!metaFile) {
-        // 메타데이터 없음 = 만료됨
+bool CacheManager::clockSynced() {
+    if (_clockSynced) {
         return true;
     }
+    if (!gTimeManager.isSynced()) {
+        return false;
+    }
 
-    // 만료 시간 읽기 (8바이트 unsigned long)
-    unsigned long expiryTime = 0;
-    size_t bytesRead = metaFile.read((uint8_t*)&expiryTime, sizeof(expiryTime));
-    metaFile.close();
+    // 최초 동기화: 이번 부팅의 millis 시각은 Unix 시각으로 변환 (RAM 인덱스만,
+    // 레코드는 다음 set()/flush 때 갱신), 이전 부팅의 항목은 나이를 알 수 없으므로
+    // 지금 만료된 것으로 보고 stale 기간 동안만 유지
+    uint32_t nowUnix = gTimeManager.getTimestamp();
+    unsigned long nowMillis = millis();
+
+    for (int i = 0; i < LITTLEFS_CACHE_MAX_ENTRIES; i++) {
+        IndexEntry& entry = _index[i];
+        if (entry.hash == 0 || (entry.flags & ENTRY_FLAG_WALLCLOCK)) {
+            continue;
+        }
 
-    if (bytesRead != sizeof(expiryTime)) {
-        return true;  // 읽기 실패 = 만료됨
+        if (entry.flags & ENTRY_FLAG_PREV_BOOT) {
+            entry.expiry = nowUnix;
+            entry.written = nowUnix;
+            entry.flags = (entry.flags & ~ENTRY_FLAG_PREV_BOOT) | ENTRY_FLAG_AGE_UNKNOWN;
+        } else {
+            // 부호 있는 차이 (이미 만료된 항목은 음수)
+            entry.expiry = nowUnix + (int32_t)(entry.expiry - nowMillis) / 1000;
+            entry.written = nowUnix - (nowMillis - entry.written) / 1000;
+        }
+        entry.flags |= ENTRY_FLAG_WALLCLOCK;
     }
 
-    // @MX:NOTE: [millis 오버플로우] millis()는 약 49일 후 0으로 되돌아감
-    // 오버플로우 고려: 만료 시간이 현재 시간보다 작으면 만료로 간주
-    // 오버플로우 시나리오: expiryTime=0xFFFFFFFF, millis()=0x00000100
-    // (expiryTime - millis())이 큰 양수이면 아직 유효
+    _clockSynced = true;
+    heapRebuild();  // 등록 대상이 millis 항목에서 Unix 시각 항목으로 바뀜
+    return true;
+}
 
-    unsigned long now = millis();
-    unsigned long remaining = expiryTime - now;
+CacheManager::Freshness CacheManager::freshness(const IndexEntry& entry) {
+    // 최초 동기화 시 entry의 expiry/flags가 바뀌므로 먼저 확인
+    bool synced = clockSynced();
 
-    // remaining이 0xFFFFFFFF보다 크면 오버플로우 발생 (음수로 계산됨)
-    // 즉, remaining > 0x7FFFFFFF 이면 만료로 간주 (대략 24일 이상 차이)
-    if (remaining > 0x7FFFFFFFUL) {
-        return true;
+    int32_t past;      // 만료 후 경과 시간 (음수면 아직 유효)
+    uint32_t window;   // stale 유지 기간 (같은 단위)
+
+    if (entry.flags & ENTRY_FLAG_WALLCLOCK) {
+        if (!synced) {
+            return UNKNOWN_AGE;  // 재부팅 직후 NTP 동기화 전
+        }
+        // 차이가 2^31초 이상 날 일은 없으므로 부호 있는 비교로 충분
+        past = (int32_t)(gTimeManager.getTimestamp() - entry.expiry);
+        window = _staleWindow / 1000;
+    } else {
+        // 이전 부팅의 millis expiry는 판단 불가 (동기화 시 재계산됨)
+        if (entry.flags & ENTRY_FLAG_PREV_BOOT) {
+            return UNKNOWN_AGE;
+        }
+
+        // @MX:NOTE: [millis 오버플로우] millis()는 약 49일 후 0으로 되돌아감
+        // 부호 있는 차이로 비교하면 약 24일 이내의 차이는 오버플로우와 무관하게 정확
+        past = (int32_t)(millis() - entry.expiry);
+        window = _staleWindow;
     }
 
-    return false;
+    if (past < 0) {
+        return FRESH;
+    }
+    // @MX:NOTE: [stale-while-revalidate] 만료 후 stale 기간 동안은 getStale()로만 조회 가능
+    return (uint32_t)past < window ? STALE : EXPIRED;
 }
 
-bool CacheManager::get(const char* key, char* outValue, size_t maxLen) {
-    // 만료 체크
-    if (isExpired(key)) {
-        remove(key);  // 만료된 항목 삭제
+long CacheManager::entryAge(const IndexEntry& entry) {
+    if (entry.flags & ENTRY_FLAG_AGE_UNKNOWN) {
+        return -1;
+    }
+    if (entry.flags & ENTRY_FLAG_WALLCLOCK) {
+        if (!clockSynced()) {
+            return -1;
+        }
+        return (long)(gTimeManager.getTimestamp() - entry.written) * 1000L;
+    }
+    if (entry.flags & ENTRY_FLAG_PREV_BOOT) {
+        return -1;
+    }
+    return (long)(millis() - entry.written);
+}
+
+uint32_t CacheManager::removalTime(const IndexEntry& entry) const {
+    return entry.expiry + ((entry.flags & ENTRY_FLAG_WALLCLOCK) ? _staleWindow / 1000 : _staleWindow);
+}
+
+bool CacheManager::createSegment() {
+    if (_writer != nullptr) {
+        abortWrite(*_writer);
+    }
+
+    File seg = LittleFS.open(LITTLEFS_CACHE_SEGMENT_FILE, "w");
+    if (!seg) {
+        Serial.println(F("[CacheMgr] Failed to create segment"));
         return false;
     }
 
-    char filePath[LITTLEFS_MAX_PATH_LEN];
-    getFilePath(key, filePath, sizeof(filePath));
+    uint32_t magic = SEGMENT_MAGIC;
+    size_t written = seg.write((const uint8_t*)&magic, sizeof(magic));
+    seg.close();
+
+    memset(_index, 0, sizeof(_index));
+    memset(_hot, 0, sizeof(_hot));
+    heapRebuild();
+    _dirtyCount = 0;
+    _segmentSize = sizeof(magic);
+    _deadBytes = 0;
+    _tornTail = false;
+    _liveBytes = 0;
+    _liveCount = 0;
+    return written == sizeof(magic);
+}
+
+bool CacheManager::rebuildIndex() {
+    memset(_index, 0, sizeof(_index));
+    _segmentSize = 0;
+    _deadBytes = 0;
+
+    File seg = LittleFS.open(LITTLEFS_CACHE_SEGMENT_FILE, "r");
+    if (!seg) {
+        return createSegment();
+    }
+
+    uint32_t magic = 0;
+    if (seg.read((uint8_t*)&magic, sizeof(magic)) != sizeof(magic) || magic != SEGMENT_MAGIC) {
+        seg.close();
+        // 이전 레코드 포맷 (ACL1) 포함 - 캐시이므로 변환 없이 비움
+        Serial.println(F("[CacheMgr] Unknown segment format, resetting"));
+        return createSegment();
+    }
+
+    size_t fileSize = seg.size();
+    size_t pos = sizeof(magic);
+    RecordHeader hdr;
+    char key[LITTLEFS_MAX_KEY_LEN];
+
+    // @MX:NOTE: [부팅 스캔] 레코드 헤더와 키만 읽고 값은 seek로 건너뜀
+    while (pos + sizeof(hdr) <= fileSize) {
+        if (seg.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr)) {
+            break;
+        }
+        if (hdr.magic != RECORD_MAGIC ||
+            hdr.keyLen == 0 || hdr.keyLen >= LITTLEFS_MAX_KEY_LEN ||
+            hdr.valueLen > LITTLEFS_MAX_CACHE_SIZE ||
+            pos + recordSize(hdr.keyLen, hdr.valueLen) > fileSize) {
+            break;  // 손상된 꼬리
+        }
+        if (seg.read((uint8_t*)key, hdr.keyLen) != hdr.keyLen) {
+            break;
+        }
+        key[hdr.keyLen] = '\0';
+
+        size_t size = recordSize(hdr.keyLen, hdr.valueLen);
+        uint32_t hash = hashKey(key);
+        IndexEntry* entry = findEntry(hash);
+
+        if (entry != nullptr) {
+            // 같은 키의 이전 레코드는 무효화
+            // (set()/openWrite()가 해시가 같은 다른 키를 거부하므로 한 해시에 살아있는 키는
+            // 하나뿐 - 다른 키라면 이전 키는 이미 삭제/evict된 것)
+            _deadBytes += recordSize(entry->keyLen, entry->valueLen);
+            entry->hash = 0;
+        }
+
+        if (hdr.flags & RECORD_FLAG_TOMBSTONE) {
+            _deadBytes += size;
+        } else if ((entry = allocEntry()) != nullptr) {
+            entry->hash = hash;
+            entry->offset = pos;
+            entry->expiry = hdr.expiry;
+            entry->written = hdr.written;
+            entry->lastUse = ++_lruTick;  // 나중에 기록된 레코드일수록 최근 사용
+            entry->valueLen = hdr.valueLen;
+            entry->keyLen = hdr.keyLen;
+            entry->flags = ((hdr.flags & RECORD_FLAG_WALLCLOCK) ? ENTRY_FLAG_WALLCLOCK
+                                                                 : ENTRY_FLAG_PREV_BOOT) |
+                           (hdr.flags & TYPE_MASK);
+        } else {
+            _deadBytes += size;  // 인덱스 가득 참 - 다음 컴팩션에서 버려짐
+        }
+
+        pos += size;
+        seg.seek(pos);
+    }
+    seg.close();
+
+    _segmentSize = pos;
+    heapRebuild();
+
+    _liveBytes = 0;
+    _liveCount = 0;
+    for (int i = 0; i < LITTLEFS_CACHE_MAX_ENTRIES; i++) {
+        if (_index[i].hash != 0) {
+            usageAdd(_index[i]);
+        }
+    }
+
+    if (pos != fileSize) {
+        // 손상된 꼬리 뒤에 append 하면 다음 부팅에서 유실되므로 즉시 재작성
+        Serial.println(F("[CacheMgr] Truncated segment tail, compacting"));
+        return compact();
+    }
+
+    maybeCompact();
+    return true;
+}
 
-    File file = LittleFS.open(filePath, "r");
-    if (!file) {
+bool CacheManager::appendRecord(const char* key, uint8_t keyLen, const uint8_t* value,
+                                size_t valueLen, uint32_t expiry, uint32_t written,
+                                uint8_t flags, uint32_t& outOffset) {
+    if (segmentBusy() || !repairTail()) {
         return false;
     }
 
-    // 값 읽기
-    size_t bytesRead = file.read((uint8_t*)outValue, maxLen - 1);
-    file.close();
+    File seg = LittleFS.open(LITTLEFS_CACHE_SEGMENT_FILE, "a");
+    if (!seg) {
+        Serial.println(F("[CacheMgr] Failed to open segment"));
+        return false;
+    }
+
+    bool ok = writeRecord(seg, key, keyLen, value, valueLen, expiry, written, flags, outOffset);
+    seg.close();
+    if (!ok) {
+        repairTail();
+    }
+    return ok;
+}
+
+bool CacheManager::writeRecord(File& seg, const char* key, uint8_t keyLen, const uint8_t* value,
+                               size_t valueLen, uint32_t expiry, uint32_t written,
+                               uint8_t flags, uint32_t& outOffset) {
+    RecordHeader hdr;
+    hdr.magic = RECORD_MAGIC;
+    hdr.flags = flags;
+    hdr.keyLen = keyLen;
+    hdr.reserved = 0;
+    hdr.expiry = expiry;
+    hdr.valueLen = valueLen;
+    hdr.written = written;
+
+    size_t bytes = seg.write((const uint8_t*)&hdr, sizeof(hdr));
+    bytes += seg.write((const uint8_t*)key, keyLen);
+    if (valueLen > 0) {
+        bytes += seg.write(value, valueLen);
+    }
 
-    if (bytesRead == 0) {
+    size_t expected = recordSize(keyLen, valueLen);
+    if (bytes != expected) {
+        Serial.print(F("[CacheMgr] Write mismatch: "));
+        Serial.print((unsigned long)bytes);
+        Serial.print(F(" vs "));
+        Serial.println((unsigned long)expected);
+        // 부분 기록을 남긴 채 append 하면 세그먼트 중간의 손상 헤더가 되어
+        // 부팅 스캔이 이후 레코드를 잘못 읽으므로 레코드 시작 위치로 되돌림
+        if (!seg.truncate(_segmentSize)) {
+            _segmentSize += bytes;
+            _deadBytes += bytes;
+            _tornTail = true;  // 세그먼트를 닫은 뒤 repairTail()에서 컴팩션
+        }
         return false;
     }
 
-    outValue[bytesRead] = '\0';
+    outOffset = _segmentSize;
+    _segmentSize += expected;
     return true;
 }
 
-bool CacheManager::set(const char* key, const char* value, unsigned long ttlMillis) {
-    char filePath[LITTLEFS_MAX_PATH_LEN];
-    char metaPath[LITTLEFS_MAX_PATH_LEN];
+void CacheManager::releaseRecord(IndexEntry& entry) {
+    if (entry.hash == 0) {
+        return;
+    }
+    if (!(entry.flags & ENTRY_FLAG_DIRTY)) {
+        // 이전 레코드 무효화 (레코드 자체는 컴팩션 때 제거)
+        _deadBytes += recordSize(entry.keyLen, entry.valueLen);
+    }
+    usageRemove(entry);
+}
+
+bool CacheManager::entryKey(const IndexEntry& entry, File& seg, char* outKey) {
+    // dirty 항목은 세그먼트 레코드가 없으므로 hot 슬롯에서 복원
+    HotSlot* slot = hotSlotFor(entry.hash);
+    if (slot != nullptr) {
+        memcpy(outKey, slot->data, slot->keyLen);
+        outKey[slot->keyLen] = '\0';
+        return true;
+    }
+    if (entry.flags & ENTRY_FLAG_DIRTY) {
+        return false;
+    }
 
-    getFilePath(key, filePath, sizeof(filePath));
-    getMetaPath(key, metaPath, sizeof(metaPath));
+    if (!seg) {
+        seg = LittleFS.open(LITTLEFS_CACHE_SEGMENT_FILE, "r");
+        if (!seg) {
+            return false;
+        }
+    }
 
-    // 값 파일 쓰기
-    File dataFile = LittleFS.open(filePath, "w");
-    if (!dataFile) {
-        Serial.print(F("[CacheMgr] Failed to open data file: "));
-        Serial.println(filePath);
+    RecordHeader hdr;
+    seg.seek(entry.offset);
+    if (seg.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr) ||
+        seg.read((uint8_t*)outKey, entry.keyLen) != entry.keyLen) {
         return false;
     }
+    outKey[entry.keyLen] = '\0';
+    return true;
+}
 
-    size_t valueLen = strlen(value);
-    size_t written = dataFile.write((const uint8_t*)value, valueLen);
-    dataFile.close();
+bool CacheManager::removeEntry(IndexEntry* entry, const char* key, uint8_t keyLen) {
+    uint32_t offset;
+    if (!(entry->flags & ENTRY_FLAG_DIRTY)) {
+        _deadBytes += recordSize(entry->keyLen, entry->valueLen);
+    }
+    usageRemove(*entry);
+    hotDrop(entry->hash);
+    entry->hash = 0;
+    entry->flags = 0;
+    heapUpdate(entry);
 
-    if (written != valueLen) {
-        Serial.print(F("[CacheMgr] Write mismatch: "));
-        Serial.print(written);
-        Serial.print(F(" vs "));
-        Serial.println(valueLen);
+    // tombstone이 없으면 재부팅 후 이전 레코드가 되살아남
+    if (!appendRecord(key, keyLen, nullptr, 0, 0, 0, RECORD_FLAG_TOMBSTONE, offset)) {
         return false;
     }
+    _deadBytes += recordSize(keyLen, 0);
+    return true;
+}
+
+bool CacheManager::openRecord(const IndexEntry& entry, const char* key, File& seg) {
+    if (entry.flags & ENTRY_FLAG_DIRTY) {
+        return false;  // 해시 충돌 - dirty 값은 다른 키의 것
+    }
 
-    // 메타데이터 파일 쓰기 (만료 시간)
-    File metaFile = LittleFS.open(metaPath, "w");
-    if (!metaFile) {
-        Serial.print(F("[CacheMgr] Failed to open meta file: "));
-        Serial.println(metaPath);
+    seg = LittleFS.open(LITTLEFS_CACHE_SEGMENT_FILE, "r");
+    if (!seg) {
         return false;
     }
 
-    unsigned long expiryTime = getExpiryTime(ttlMillis);
-    written = metaFile.write((const uint8_t*)&expiryTime, sizeof(expiryTime));
-    metaFile.close();
+    // 해시 충돌 방지: 레코드의 키와 비교
+    RecordHeader hdr;
+    char storedKey[LITTLEFS_MAX_KEY_LEN];
+    seg.seek(entry.offset);
+    if (seg.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr) ||
+        hdr.keyLen != entry.keyLen ||
+        seg.read((uint8_t*)storedKey, hdr.keyLen) != hdr.keyLen ||
+        strncmp(storedKey, key, hdr.keyLen) != 0 || key[hdr.keyLen] != '\0') {
+        seg.close();
+        return false;
+    }
+    return true;
+}
+
+bool CacheManager::get(const char* key, char* outValue, size_t maxLen) {
+    size_t len;
+    if (maxLen == 0 || !readValue(key, TYPE_STRING, (uint8_t*)outValue, maxLen - 1, len, nullptr)) {
+        return false;
+    }
+    outValue[len] = '\0';
+    return len > 0;
+}
 
-    if (written != sizeof(expiryTime)) {
-        Serial.println(F("[CacheMgr] Meta write failed"));
+bool CacheManager::getStale(const char* key, char* outValue, size_t maxLen, long& outAgeMs) {
+    size_t len;
+    if (maxLen == 0 || !readValue(key, TYPE_STRING, (uint8_t*)outValue, maxLen - 1, len, &outAgeMs)) {
         return false;
     }
+    outValue[len] = '\0';
+    return len > 0;
+}
+
+bool CacheManager::checkEntry(IndexEntry* entry, const char* key, long* outAgeMs) {
+    switch (freshness(*entry)) {
+        case EXPIRED:
+            removeEntry(entry, key, strlen(key));  // stale 기간도 지난 항목 삭제
+            maybeCompact();
+            return false;
+        case STALE:
+            if (outAgeMs == nullptr) {
+                return false;
+            }
+            requestRevalidate(entry->hash, key);
+            break;
+        default:
+            break;
+    }
 
+    if (outAgeMs != nullptr) {
+        *outAgeMs = entryAge(*entry);
+    }
     return true;
 }
 
-bool CacheManager::has(const char* key) {
-    // 만료 체크 포함
-    if (isExpired(key)) {
-        remove(key);
+bool CacheManager::readValue(const char* key, uint8_t type, uint8_t* out, size_t maxLen,
+                             size_t& outLen, long* outAgeMs) {
+    uint32_t hash = hashKey(key);
+    size_t keyLen = strlen(key);
+    IndexEntry* entry = findEntry(hash);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    // 만료 삭제보다 키 확인이 먼저 (해시가 같은 다른 키의 항목을 지우지 않도록)
+    // hot tier 적중 시 플래시 접근 없음
+    HotSlot* slot = hotFind(hash, key, keyLen);
+    File seg;
+    if (slot == nullptr && !openRecord(*entry, key, seg)) {
+        return false;
+    }
+    if (freshness(*entry) == EXPIRED) {
+        seg.close();  // 삭제/컴팩션 전에 닫음
+    }
+    if (!checkEntry(entry, key, outAgeMs)) {
+        seg.close();
+        return false;
+    }
+    touch(entry);
+
+    // 타입이 다르거나 고정 크기 값의 크기가 다르면 (구조체 변경 등) 없는 것으로 처리
+    if (entryType(*entry) != type || (type != TYPE_STRING && entry->valueLen != maxLen)) {
+        seg.close();
+        return false;
+    }
+
+    if (slot != nullptr) {
+        _hotHits++;
+        outLen = slot->valueLen < maxLen ? slot->valueLen : maxLen;
+        memcpy(out, slot->data + slot->keyLen, outLen);
+        return true;
+    }
+    _hotMisses++;
+
+    // 값 읽기
+    size_t toRead = entry->valueLen < maxLen ? entry->valueLen : maxLen;
+    size_t bytesRead = seg.read(out, toRead);
+    seg.close();
+
+    if (bytesRead == 0 && toRead > 0) {
         return false;
     }
 
-    char filePath[LITTLEFS_MAX_PATH_LEN];
-    getFilePath(key, filePath, sizeof(filePath));
-    return LittleFS.exists(filePath);
+    // 값 전체를 읽은 경우에만 hot tier에 올림
+    if (bytesRead == entry->valueLen) {
+        hotPut(hash, key, keyLen, (const char*)out, bytesRead, false);
+    }
+    outLen = bytesRead;
+    return true;
 }
 
-bool CacheManager::remove(const char* key) {
-    char filePath[LITTLEFS_MAX_PATH_LEN];
-    char metaPath[LITTLEFS_MAX_PATH_LEN];
+bool CacheManager::getValue(const char* key, uint8_t type, void* out, size_t size) {
+    size_t len;
+    return readValue(key, type, (uint8_t*)out, size, len, nullptr) && len == size;
+}
 
-    getFilePath(key, filePath, sizeof(filePath));
-    getMetaPath(key, metaPath, sizeof(metaPath));
+bool CacheManager::openRead(const char* key, CacheReader& reader, long* outAgeMs) {
+    reader.close();
 
-    bool result = true;
+    uint32_t hash = hashKey(key);
+    size_t keyLen = strlen(key);
+    IndexEntry* entry = findEntry(hash);
+    if (entry == nullptr) {
+        return false;
+    }
 
-    if (LittleFS.exists(filePath)) {
-        if (!LittleFS.remove(filePath)) {
-            result = false;
-        }
+    // 만료 삭제보다 키 확인이 먼저 (readValue()와 같음)
+    HotSlot* slot = hotFind(hash, key, keyLen);
+    if (slot == nullptr && !openRecord(*entry, key, reader._file)) {
+        return false;
+    }
+    if (freshness(*entry) == EXPIRED) {
+        reader._file.close();
+    }
+    if (!checkEntry(entry, key, outAgeMs)) {
+        reader._file.close();
+        return false;
+    }
+
+    // hot 슬롯은 다른 호출에서 evict될 수 있으므로 reader 쪽으로 복사
+    if (slot != nullptr) {
+        _hotHits++;
+        memcpy(reader._ram, slot->data + slot->keyLen, slot->valueLen);
+        reader._fromRam = true;
+        reader._size = slot->valueLen;
+        reader._remaining = slot->valueLen;
+        return true;
+    }
+    _hotMisses++;
+
+    reader._fromRam = false;
+    reader._size = entry->valueLen;
+    reader._remaining = entry->valueLen;
+    return true;
+}
+
+bool CacheManager::openWrite(const char* key, CacheWriter& writer, unsigned long ttlMillis) {
+    writer.abort();
+
+    size_t keyLen = strlen(key);
+    if (keyLen == 0 || keyLen >= LITTLEFS_MAX_KEY_LEN) {
+        Serial.print(F("[CacheMgr] Invalid key: "));
+        Serial.println(key);
+        return false;
+    }
+    if (segmentBusy()) {
+        return false;
     }
 
-    if (LittleFS.exists(metaPath)) {
-        if (!LittleFS.remove(metaPath)) {
-            result = false;
+    uint32_t hash = hashKey(key);
+    bool collision;
+    if (findKey(hash, key, keyLen, collision) == nullptr) {
+        if (collision) {
+            Serial.print(F("[CacheMgr] Key hash collision: "));
+            Serial.println(key);
+            return false;
+        }
+        if (allocEntry() == nullptr) {
+            Serial.println(F("[CacheMgr] Index full"));
+            return false;
         }
     }
 
-    return result;
+    // 항목 수 quota는 기록 전에 확보 (스트리밍 중에는 세그먼트가 잠겨 evict tombstone을 쓸 수 없음)
+    if (!makeRoom(hash, recordSize(keyLen, 0))) {
+        return false;
+    }
+
+    // "a" 모드는 seek 후 기록이 불가하므로 헤더 갱신을 위해 "r+" 사용
+    File seg = LittleFS.open(LITTLEFS_CACHE_SEGMENT_FILE, "r+");
+    if (!seg) {
+        Serial.println(F("[CacheMgr] Failed to open segment"));
+        return false;
+    }
+
+    // @MX:NOTE: [스트리밍 기록] 헤더는 magic 0으로 먼저 기록하고 commit()에서 채움
+    // commit 전에 전원이 꺼지면 부팅 스캔이 손상된 꼬리로 보고 잘라냄
+    RecordHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    seg.seek(_segmentSize);
+    size_t written = seg.write((const uint8_t*)&hdr, sizeof(hdr));
+    written += seg.write((const uint8_t*)key, keyLen);
+    if (written != sizeof(hdr) + keyLen) {
+        Serial.println(F("[CacheMgr] Stream write open FAILED"));
+        seg.truncate(_segmentSize);
+        seg.close();
+        return false;
+    }
+
+    writer._owner = this;
+    writer._file = seg;
+    writer._offset = _segmentSize;
+    writer._hash = hash;
+    writer._expiry = getExpiryTime(ttlMillis, writer._clockFlags, writer._written);
+    writer._valueLen = 0;
+    writer._keyLen = keyLen;
+    writer._failed = false;
+    _writer = &writer;
+    return true;
 }
 
-long CacheManager::getTTL(const char* key) {
-    char metaPath[LITTLEFS_MAX_PATH_LEN];
-    getMetaPath(key, metaPath, sizeof(metaPath));
+bool CacheManager::commitWrite(CacheWriter& writer) {
+    if (writer._failed) {
+        Serial.println(F("[CacheMgr] Stream write FAILED"));
+        abortWrite(writer);
+        return false;
+    }
 
-    File metaFile = LittleFS.open(metaPath, "r");
-    if (!metaFile) {
-        return -1;
+    size_t size = recordSize(writer._keyLen, writer._valueLen);
+    if (size > _quotaBytes) {
+        Serial.println(F("[CacheMgr] Stream value exceeds quota"));
+        abortWrite(writer);
+        return false;
     }
 
-    unsigned long expiryTime = 0;
-    size_t bytesRead = metaFile.read((uint8_t*)&expiryTime, sizeof(expiryTime));
-    metaFile.close();
+    RecordHeader hdr;
+    hdr.magic = RECORD_MAGIC;
+    hdr.flags = (writer._clockFlags & ENTRY_FLAG_WALLCLOCK) ? RECORD_FLAG_WALLCLOCK : 0;
+    hdr.keyLen = writer._keyLen;
+    hdr.reserved = 0;
+    hdr.expiry = writer._expiry;
+    hdr.valueLen = writer._valueLen;
+    hdr.written = writer._written;
 
-    if (bytesRead != sizeof(expiryTime)) {
-        return -1;
+    writer._file.seek(writer._offset);
+    if (writer._file.write((const uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr)) {
+        Serial.println(F("[CacheMgr] Stream header write FAILED"));
+        abortWrite(writer);
+        return false;
     }
+    writer._file.close();
+    writer._owner = nullptr;
+    _writer = nullptr;
+    _segmentSize = writer._offset + size;
 
-    unsigned long now = millis();
-    long remaining = (long)(expiryTime - now);
+    // 항목 수는 openWrite()에서 확보함 - 여기서는 값 크기만큼의 바이트 quota만 evict
+    IndexEntry* entry = nullptr;
+    if (makeRoom(writer._hash, size)) {
+        entry = findEntry(writer._hash);
+        if (entry == nullptr) {
+            entry = allocEntry();
+        }
+    }
+    if (entry == nullptr) {
+        // 레코드는 이미 기록됨 - 인덱스 밖에 남으면 재부팅 후 되살아나므로
+        // 컴팩션으로 제거 (이전 값 유지), 컴팩션도 실패하면 tombstone으로 키 삭제
+        Serial.println(F("[CacheMgr] Index full"));
+        _deadBytes += size;
+        if (!compact()) {
+            discardRecord(writer);
+        }
+        return false;
+    }
+
+    releaseRecord(*entry);
+    hotDrop(writer._hash);  // 이전 값 (dirty 포함)은 새 레코드로 대체
+
+    entry->hash = writer._hash;
+    entry->offset = writer._offset;
+    entry->expiry = writer._expiry;
+    entry->written = writer._written;
+    entry->valueLen = writer._valueLen;
+    entry->keyLen = writer._keyLen;
+    entry->flags = writer._clockFlags;
+    touch(entry);
+    usageAdd(*entry);
+    heapUpdate(entry);
+
+    maybeCompact();
+    return true;
+}
+
+void CacheManager::discardRecord(const CacheWriter& writer) {
+    IndexEntry record;
+    memset(&record, 0, sizeof(record));
+    record.hash = writer._hash;
+    record.offset = writer._offset;
+    record.keyLen = writer._keyLen;
 
-    // 오버플로우 체크
-    if (remaining < 0 || (unsigned long)remaining > 0x7FFFFFFFUL) {
-        return -1;  // 만료됨
+    char key[LITTLEFS_MAX_KEY_LEN];
+    File seg;
+    bool found = entryKey(record, seg, key);
+    if (seg) {
+        seg.close();
+    }
+    if (!found) {
+        return;
     }
 
-    return remaining;
+    // 이전 값의 레코드는 새 레코드보다 앞에 있으므로 tombstone 하나로 함께 무효화됨
+    IndexEntry* existing = findEntry(writer._hash);
+    if (existing != nullptr) {
+        removeEntry(existing, key, writer._keyLen);
+        return;
+    }
+    uint32_t offset;
+    if (appendRecord(key, writer._keyLen, nullptr, 0, 0, 0, RECORD_FLAG_TOMBSTONE, offset)) {
+        _deadBytes += recordSize(writer._keyLen, 0);
+    }
 }
 
-int CacheManager::cleanup() {
-    int cleaned = 0;
-    Dir dir = LittleFS.openDir(LITTLEFS_DIR_CACHE);
-
-    while (dir.next()) {
-        // 메타데이터 파일만 체크
-        const char* fileName = dir.fileName().c_str();
-
-        // .key.meta 형식 확인
-        if (fileName[0] == '.' && strstr(fileName, ".meta") != nullptr) {
-            // 키 추출: ".key.meta" -> "key"
-            char key[LITTLEFS_MAX_KEY_LEN];
-            strncpy(key, fileName + 1, sizeof(key) - 1);
-            key[sizeof(key) - 1] = '\0';
-
-            // ".meta" 제거
-            char* dotMeta = strstr(key, ".meta");
-            if (dotMeta) {
-                *dotMeta = '\0';
-            }
+void CacheManager::abortWrite(CacheWriter& writer) {
+    bool truncated = writer._file.truncate(writer._offset);
+    writer._file.close();
+    writer._owner = nullptr;
+    _writer = nullptr;
+
+    if (!truncated) {
+        // 잘리지 않은 부분 레코드 뒤에 append 하면 다음 부팅에서 유실되므로 재작성
+        size_t partial = recordSize(writer._keyLen, writer._valueLen);
+        _segmentSize = writer._offset + partial;
+        _deadBytes += partial;
+        compact();
+    }
+}
+
+bool CacheManager::segmentBusy() const {
+    if (_writer != nullptr) {
+        Serial.println(F("[CacheMgr] Segment busy (stream write in progress)"));
+        return true;
+    }
+    return false;
+}
+
+bool CacheManager::set(const char* key, const char* value, unsigned long ttlMillis) {
+    return setValue(key, (const uint8_t*)value, strlen(value), TYPE_STRING, ttlMillis);
+}
+
+bool CacheManager::setValue(const char* key, const uint8_t* value, size_t valueLen,
+                            uint8_t type, unsigned long ttlMillis) {
+    size_t keyLen = strlen(key);
+    if (keyLen == 0 || keyLen >= LITTLEFS_MAX_KEY_LEN) {
+        Serial.print(F("[CacheMgr] Invalid key: "));
+        Serial.println(key);
+        return false;
+    }
+
+    if (valueLen > LITTLEFS_MAX_CACHE_SIZE) {
+        Serial.print(F("[CacheMgr] Value too large: "));
+        Serial.println((unsigned long)valueLen);
+        return false;
+    }
+
+    // 해시가 같은 다른 키를 덮어쓰지 않음 (evict 전에 확인)
+    uint32_t hash = hashKey(key);
+    bool collision;
+    findKey(hash, key, keyLen, collision);
+    if (collision) {
+        Serial.print(F("[CacheMgr] Key hash collision: "));
+        Serial.println(key);
+        return false;
+    }
+    if (!makeRoom(hash, recordSize(keyLen, valueLen))) {
+        return false;
+    }
+
+    // 기존 항목은 새 값이 RAM(dirty) 또는 플래시에 저장된 뒤에만 교체
+    IndexEntry* entry = findEntry(hash);
+    if (entry == nullptr) {
+        entry = allocEntry();
+        if (entry == nullptr) {
+            Serial.println(F("[CacheMgr] Index full"));
+            return false;
+        }
+    }
+
+    uint8_t clockFlags;
+    uint32_t written;
+    uint32_t expiry = getExpiryTime(ttlMillis, clockFlags, written);
+    uint8_t typeBits = (type << TYPE_SHIFT) & TYPE_MASK;
+
+    // @MX:NOTE: [write-behind] 같은 키의 반복 set()은 dirty 슬롯 하나로 병합됨
+    if (_writeBehind && keyLen + valueLen <= LITTLEFS_CACHE_HOT_SLOT_SIZE) {
+        bool stored = hotPut(hash, key, keyLen, (const char*)value, valueLen, true);
+        if (!stored && flush() >= 0) {
+            // 모든 슬롯이 dirty였음
+            stored = hotPut(hash, key, keyLen, (const char*)value, valueLen, true);
+        }
+        if (stored) {
+            releaseRecord(*entry);
+            entry->hash = hash;
+            entry->offset = 0;
+            entry->expiry = expiry;
+            entry->written = written;
+            entry->valueLen = valueLen;
+            entry->keyLen = keyLen;
+            entry->flags = ENTRY_FLAG_DIRTY | clockFlags | typeBits;
+            touch(entry);
+            usageAdd(*entry);
+            heapUpdate(entry);
 
-            // 만료 체크
-            if (isExpired(key)) {
-                remove(key);
-                cleaned++;
+            if (_dirtyCount >= _flushDirtyMax) {
+                flush();
             }
+            return true;
         }
     }
 
-    if (cleaned > 0) {
-        Serial.print(F("[CacheMgr] Cleaned "));
-        Serial.print(cleaned);
-        Serial.println(F(" expired items"));
+    // write-through: 플래시 기록 성공 후 RAM 사본 갱신
+    // 실패하면 이전 값 (dirty 포함)이 인덱스와 hot tier에 그대로 남음
+    uint32_t offset;
+    uint8_t recordFlags = ((clockFlags & ENTRY_FLAG_WALLCLOCK) ? RECORD_FLAG_WALLCLOCK : 0) | typeBits;
+    if (!appendRecord(key, keyLen, value, valueLen, expiry, written, recordFlags, offset)) {
+        return false;
     }
 
-    return cleaned;
+    releaseRecord(*entry);
+    hotPut(hash, key, keyLen, (const char*)value, valueLen, false);  // 같은 키 슬롯 (dirty 포함) 대체
+
+    entry->hash = hash;
+    entry->offset = offset;
+    entry->expiry = expiry;
+    entry->written = written;
+    entry->valueLen = valueLen;
+    entry->keyLen = keyLen;
+    entry->flags = clockFlags | typeBits;
+    touch(entry);
+    usageAdd(*entry);
+    heapUpdate(entry);
+
+    maybeCompact();
+    return true;
 }
 
-bool CacheManager::clear() {
-    Dir dir = LittleFS.openDir(LITTLEFS_DIR_CACHE);
+bool CacheManager::has(const char* key) {
+    bool collision;
+    IndexEntry* entry = findKey(hashKey(key), key, strlen(key), collision);
+
+    // 만료 체크 포함 (stale 항목은 없는 것으로 처리)
+    return entry != nullptr && checkEntry(entry, key, nullptr);
+}
 
-    while (dir.next()) {
-        const char* fileName = dir.fileName().c_str();
-        char fullPath[LITTLEFS_MAX_PATH_LEN];
-        snprintf(fullPath, sizeof(fullPath), "%s%s", LITTLEFS_CACHE_PREFIX, fileName);
-        LittleFS.remove(fullPath);
+bool CacheManager::remove(const char* key) {
+    bool collision;
+    IndexEntry* entry = findKey(hashKey(key), key, strlen(key), collision);
+    if (entry == nullptr) {
+        return true;  // 이미 없음 (해시가 같은 다른 키는 그대로 둠)
     }
 
-    Serial.println(F("[CacheMgr] All cache cleared"));
-    return true;
+    bool result = removeEntry(entry, key, strlen(key));
+    maybeCompact();
+    return result;
 }
 
-int CacheManager::count() {
-    int count = 0;
-    Dir dir = LittleFS.openDir(LITTLEFS_DIR_CACHE);
+long CacheManager::getTTL(const char* key) {
+    bool collision;
+    IndexEntry* entry = findKey(hashKey(key), key, strlen(key), collision);
+    if (entry == nullptr) {
+        return -1;  // 없음
+    }
 
-    while (dir.next()) {
-        const char* fileName = dir.fileName().c_str();
-        // 데이터 파일만 카운트 (.meta 제외)
-        if (fileName[0] != '.') {
-            count++;
-        }
+    switch (freshness(*entry)) {
+        case EXPIRED:
+        case STALE:
+            return -1;
+        case UNKNOWN_AGE:
+            return TTL_UNKNOWN;
+        default:
+            break;
     }
 
-    return count / 2;  // 데이터 + 메타데이터 쌍이므로 2로 나눔
+    if (entry->flags & ENTRY_FLAG_WALLCLOCK) {
+        return (long)(entry->expiry - gTimeManager.getTimestamp()) * 1000L;
+    }
+    return (long)(entry->expiry - millis());
+}
+
+bool CacheManager::expireEntry(IndexEntry& entry, File& seg) {
+    if (entry.hash == 0 || !isExpired(entry)) {
+        return false;
+    }
+
+    // tombstone 기록을 위해 키 복원
+    char key[LITTLEFS_MAX_KEY_LEN];
+    if (!entryKey(entry, seg, key)) {
+        return false;
+    }
+
+    // dirty 항목은 세그먼트 레코드가 없으므로 회수할 바이트도 없음
+    size_t size = (entry.flags & ENTRY_FLAG_DIRTY) ? 0 : recordSize(entry.keyLen, entry.valueLen);
+    removeEntry(&entry, key, entry.keyLen);
+
+    _sweepStats.expired++;
+    _sweepStats.reclaimedBytes += size;
+    return true;
+}
+
+int CacheManager::cleanup() {
+    uint32_t before = _sweepStats.expired;
+    sweep(0, 0);
+    int cleaned = _sweepStats.expired - before;
+
+    if (cleaned > 0) {
+        Serial.print(F("[CacheMgr] Cleaned "));
+        Serial.print(cleaned);
+        Serial.println(F(" expired items"));
+    }
+
+    return cleaned;
+}
+
+bool CacheManager::sweep(uint8_t maxEntries, unsigned long maxMicros) {
+    // @MX:NOTE: [점진 정리] 만료 순서대로 heap 최상단만 확인 - 만료되지 않은 항목은
+    // 건드리지 않음. 비용은 만료 항목의 키 복원(read) + tombstone 기록(append)
+    unsigned long start = micros();
+    File seg;
+    int scanned = 0;
+    int cleaned = 0;
+    bool done = true;
+
+    clockSynced();  // 최초 동기화면 heap 재구성
+
+    while (_heapSize > 0 && isExpired(_index[_heap[0]])) {
+        if ((maxEntries > 0 && scanned >= maxEntries) ||
+            (maxMicros > 0 && scanned > 0 && micros() - start >= maxMicros)) {
+            done = false;
+            break;
+        }
+
+        uint8_t slot = _heap[0];
+        if (expireEntry(_index[slot], seg)) {
+            cleaned++;
+        } else {
+            heapRemove(slot);  // 키 복원 실패 - get()/has()에서 지연 삭제
+        }
+        scanned++;
+    }
+
+    if (seg) {
+        seg.close();
+    }
+    if (cleaned > 0) {
+        maybeCompact();
+    }
+
+    unsigned long elapsed = micros() - start;
+    if (elapsed > _sweepStats.maxStepMicros) {
+        _sweepStats.maxStepMicros = elapsed;
+    }
+    _sweepStats.scanned += scanned;
+    _sweepStats.inPass = !done;
+    if (done && scanned > 0) {
+        _sweepStats.passes++;
+    }
+    return done;
+}
+
+void CacheManager::setSweepBudget(uint8_t maxEntries, unsigned long maxMicros) {
+    _sweepEntries = maxEntries;
+    _sweepMicros = maxMicros;
+}
+
+CacheManager::SweepStats CacheManager::getSweepStats() const {
+    SweepStats stats = _sweepStats;
+    stats.tracked = _heapSize;
+    return stats;
+}
+
+long CacheManager::nextExpiryIn() {
+    return nextDeadlineIn(false);
+}
+
+long CacheManager::nextRemovalIn() {
+    return nextDeadlineIn(true);
+}
+
+long CacheManager::nextDeadlineIn(bool removal) {
+    clockSynced();
+    if (_heapSize == 0) {
+        return -1;
+    }
+
+    // stale 기간은 전역 상수이므로 만료 순서 = 삭제 순서 (heap 최상단이 둘 다 가장 빠름)
+    const IndexEntry& entry = _index[_heap[0]];
+    uint32_t deadline = removal ? removalTime(entry) : entry.expiry;
+    int32_t remaining;
+    if (entry.flags & ENTRY_FLAG_WALLCLOCK) {
+        remaining = (int32_t)(deadline - gTimeManager.getTimestamp());
+        return remaining > 0 ? (long)remaining * 1000L : 0;
+    }
+    remaining = (int32_t)(deadline - millis());
+    return remaining > 0 ? (long)remaining : 0;
+}
+
+int CacheManager::countExpiringWithin(unsigned long withinMs) {
+    clockSynced();
+    if (_heapSize == 0) {
+        return 0;
+    }
+
+    // 기준 시각 이후에 만료되는 노드의 자식은 볼 필요 없음 (min-heap)
+    uint32_t limit = _clockSynced ? gTimeManager.getTimestamp() + withinMs / 1000
+                                  : millis() + withinMs;
+    uint8_t stack[LITTLEFS_CACHE_MAX_ENTRIES];
+    int top = 0;
+    int found = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        uint8_t pos = stack[--top];
+        if ((int32_t)(_index[_heap[pos]].expiry - limit) > 0) {
+            continue;
+        }
+        found++;
+        for (uint8_t child = pos * 2 + 1; child <= pos * 2 + 2 && child < _heapSize; child++) {
+            stack[top++] = child;
+        }
+    }
+    return found;
+}
+
+bool CacheManager::clear() {
+    bool result = createSegment();
+    Serial.println(F("[CacheMgr] All cache cleared"));
+    return result;
+}
+
+void CacheManager::setQuota(size_t maxBytes, uint8_t maxEntries, EvictPolicy policy) {
+    _quotaBytes = maxBytes;
+    _quotaEntries = (maxEntries > 0 && maxEntries <= LITTLEFS_CACHE_MAX_ENTRIES)
+                    ? maxEntries : LITTLEFS_CACHE_MAX_ENTRIES;
+    _evictPolicy = policy;
+}
+
+bool CacheManager::makeRoom(uint32_t hash, size_t newSize) {
+    if (newSize > _quotaBytes) {
+        Serial.print(F("[CacheMgr] Value exceeds quota: "));
+        Serial.println((unsigned long)newSize);
+        return false;
+    }
+
+    // 같은 키를 덮어쓰면 기존 레코드 크기만큼 여유가 생김
+    const IndexEntry* existing = findEntry(hash);
+    size_t existingSize = existing ? recordSize(existing->keyLen, existing->valueLen) : 0;
+    int newEntries = existing ? 0 : 1;
+    int evicted = 0;
+
+    while (_liveBytes - existingSize + newSize > _quotaBytes ||
+           _liveCount + newEntries > _quotaEntries) {
+        // 스트리밍 기록 중에는 tombstone을 쓸 수 없으므로 RAM에서만 지우지 않음
+        IndexEntry* victim = evictionVictim(hash);
+        if (victim == nullptr || segmentBusy()) {
+            break;
+        }
+
+        // tombstone 기록을 위해 키 복원 (실패하면 재부팅 후 되살아나므로 중단)
+        char key[LITTLEFS_MAX_KEY_LEN];
+        File seg;
+        bool found = entryKey(*victim, seg, key);
+        if (seg) {
+            seg.close();
+        }
+        if (!found) {
+            break;
+        }
+        evicted++;
+        if (!removeEntry(victim, key, victim->keyLen)) {
+            break;
+        }
+    }
+
+    if (evicted > 0) {
+        _evictions += evicted;
+        Serial.print(F("[CacheMgr] Evicted "));
+        Serial.print(evicted);
+        Serial.println(F(" items (quota)"));
+    }
+
+    return _liveBytes - existingSize + newSize <= _quotaBytes &&
+           _liveCount + newEntries <= _quotaEntries;
+}
+
+CacheManager::IndexEntry* CacheManager::evictionVictim(uint32_t protectHash) {
+    if (_evictPolicy == EVICT_EARLIEST_EXPIRY && _heapSize > 0) {
+        // heap 최상단이 보호 대상이면 그다음 후보는 두 자식 중 하나
+        uint8_t best = _heap[0];
+        if (_index[best].hash == protectHash) {
+            best = HEAP_NONE;
+            for (uint8_t pos = 1; pos <= 2 && pos < _heapSize; pos++) {
+                if (best == HEAP_NONE || expiresBefore(_heap[pos], best)) {
+                    best = _heap[pos];
+                }
+            }
+        }
+        if (best != HEAP_NONE) {
+            return &_index[best];
+        }
+        // heap에 없는 항목 (동기화 전 나이 불명)만 남음 - LRU로 선택
+    }
+
+    IndexEntry* victim = nullptr;
+    for (int i = 0; i < LITTLEFS_CACHE_MAX_ENTRIES; i++) {
+        IndexEntry& entry = _index[i];
+        if (entry.hash == 0 || entry.hash == protectHash) {
+            continue;
+        }
+        if (victim == nullptr || entry.lastUse < victim->lastUse) {
+            victim = &entry;
+        }
+    }
+    return victim;
+}
+
+void CacheManager::maybeCompact() {
+    // 세그먼트가 임계값을 넘고 절반 이상이 무효 데이터일 때만 재작성
+    if (_segmentSize > LITTLEFS_CACHE_COMPACT_THRESHOLD && _deadBytes * 2 >= _segmentSize) {
+        compact();
+    }
+}
+
+bool CacheManager::compact() {
+    if (segmentBusy()) {
+        return false;
+    }
+
+    // dirty 값도 새 세그먼트에 포함되도록 먼저 기록
+    writeDirty();
+
+    File src = LittleFS.open(LITTLEFS_CACHE_SEGMENT_FILE, "r");
+    File dst = LittleFS.open(LITTLEFS_CACHE_COMPACT_FILE, "w");
+    if (!src || !dst) {
+        Serial.println(F("[CacheMgr] Compaction open failed"));
+        if (src) src.close();
+        if (dst) dst.close();
+        return false;
+    }
+
+    uint32_t magic = SEGMENT_MAGIC;
+    size_t pos = dst.write((const uint8_t*)&magic, sizeof(magic));
+    bool ok = (pos == sizeof(magic));
+
+    // 새 오프셋은 rename 성공 후에만 인덱스에 반영
+    uint32_t newOffsets[LITTLEFS_CACHE_MAX_ENTRIES];
+    uint8_t buf[64];
+
+    for (int i = 0; ok && i < LITTLEFS_CACHE_MAX_ENTRIES; i++) {
+        const IndexEntry& entry = _index[i];
+        if (entry.hash == 0 || (entry.flags & ENTRY_FLAG_DIRTY)) {
+            continue;
+        }
+
+        size_t remaining = recordSize(entry.keyLen, entry.valueLen);
+        newOffsets[i] = pos;
+        src.seek(entry.offset);
+
+        while (remaining > 0) {
+            size_t chunk = remaining < sizeof(buf) ? remaining : sizeof(buf);
+            if (src.read(buf, chunk) != chunk || dst.write(buf, chunk) != chunk) {
+                ok = false;
+                break;
+            }
+            remaining -= chunk;
+            pos += chunk;
+        }
+    }
+
+    src.close();
+    dst.close();
+
+    // @MX:NOTE: [원자적 교체] LittleFS rename은 대상 파일을 원자적으로 교체
+    if (!ok || !LittleFS.rename(LITTLEFS_CACHE_COMPACT_FILE, LITTLEFS_CACHE_SEGMENT_FILE)) {
+        Serial.println(F("[CacheMgr] Compaction FAILED"));
+        LittleFS.remove(LITTLEFS_CACHE_COMPACT_FILE);
+        return false;
+    }
+
+    size_t before = _segmentSize;
+    for (int i = 0; i < LITTLEFS_CACHE_MAX_ENTRIES; i++) {
+        if (_index[i].hash != 0 && !(_index[i].flags & ENTRY_FLAG_DIRTY)) {
+            _index[i].offset = newOffsets[i];
+        }
+    }
+    _segmentSize = pos;
+    _deadBytes = 0;
+    _tornTail = false;  // 인덱스에 있는 레코드만 복사되므로 부분 기록도 사라짐
+
+    Serial.print(F("[CacheMgr] Compacted "));
+    Serial.print((unsigned long)before);
+    Serial.print(F(" -> "));
+    Serial.print((unsigned long)pos);
+    Serial.println(F(" bytes"));
+    return true;
+}
+
+CacheManager::HotSlot* CacheManager::hotSlotFor(uint32_t hash) {
+    for (int i = 0; i < HOT_SLOT_COUNT; i++) {
+        if (_hot[i].hash == hash) {
+            return &_hot[i];
+        }
+    }
+    return nullptr;
+}
+
+CacheManager::HotSlot* CacheManager::hotFind(uint32_t hash, const char* key, size_t keyLen) {
+    HotSlot* slot = hotSlotFor(hash);
+    if (slot != nullptr && slot->keyLen == keyLen && memcmp(slot->data, key, keyLen) == 0) {
+        slot->lastUse = ++_hotTick;
+        return slot;
+    }
+    return nullptr;
+}
+
+bool CacheManager::hotPut(uint32_t hash, const char* key, size_t keyLen,
+                          const char* value, size_t valueLen, bool dirty) {
+    if (HOT_SLOT_COUNT == 0) {
+        return false;
+    }
+    if (keyLen + valueLen > LITTLEFS_CACHE_HOT_SLOT_SIZE) {
+        hotDrop(hash);  // 오래된 사본이 남지 않도록
+        return false;
+    }
+
+    // 같은 키 슬롯 > 빈 슬롯 > LRU clean 슬롯 순으로 선택 (dirty 슬롯은 evict 금지)
+    HotSlot* victim = hotSlotFor(hash);
+    if (victim == nullptr) {
+        for (int i = 0; i < HOT_SLOT_COUNT; i++) {
+            HotSlot& slot = _hot[i];
+            if (slot.hash == 0) {
+                victim = &slot;
+                break;
+            }
+            if (!slot.dirty && (victim == nullptr || slot.lastUse < victim->lastUse)) {
+                victim = &slot;
+            }
+        }
+        if (victim == nullptr) {
+            return false;
+        }
+    }
+
+    if (victim->dirty && !dirty) {
+        // 같은 키의 dirty 값을 write-through 값이 대체
+        _dirtyCount--;
+    } else if (!victim->dirty && dirty) {
+        if (_dirtyCount == 0) {
+            _dirtySince = millis();
+        }
+        _dirtyCount++;
+    }
+
+    victim->hash = hash;
+    victim->lastUse = ++_hotTick;
+    victim->keyLen = keyLen;
+    victim->valueLen = valueLen;
+    victim->dirty = dirty ? 1 : 0;
+    memcpy(victim->data, key, keyLen);
+    memcpy(victim->data + keyLen, value, valueLen);
+    return true;
+}
+
+void CacheManager::hotDrop(uint32_t hash) {
+    HotSlot* slot = hotSlotFor(hash);
+    if (slot != nullptr) {
+        if (slot->dirty) {
+            _dirtyCount--;
+        }
+        slot->hash = 0;
+        slot->dirty = 0;
+    }
+}
+
+void CacheManager::update() {
+    if (_dirtyCount > 0 && millis() - _dirtySince >= _flushInterval) {
+        flush();
+        return;  // flush와 sweep이 같은 loop에서 겹치지 않도록
+    }
+
+    // 재검증 훅은 loop당 1개 (훅 안에서 HTTP 요청 등이 시작될 수 있음)
+    if (_revalidatePending > 0) {
+        dispatchRevalidate();
+        return;
+    }
+
+    // 기한 도래 항목이 있을 때만 정리 (주기적 전체 순회 없음)
+    if (_mounted && _sweepEntries > 0 && nextRemovalIn() == 0) {
+        sweep(_sweepEntries, _sweepMicros);
+    }
+}
+
+int CacheManager::flush() {
+    if (!repairTail()) {
+        return -1;
+    }
+
+    int flushed = writeDirty();
+    if (flushed < 0) {
+        repairTail();  // 실패한 dirty 값은 RAM에 남아 다음 flush에서 재시도
+    } else if (flushed > 0) {
+        maybeCompact();
+    }
+    return flushed;
+}
+
+bool CacheManager::repairTail() {
+    return !_tornTail || compact();
+}
+
+int CacheManager::writeDirty() {
+    if (_dirtyCount == 0) {
+        return 0;
+    }
+    // 부분 기록 뒤에는 append 금지 (compact() 안에서 불리므로 여기서 컴팩션하지 않음)
+    if (segmentBusy() || _tornTail) {
+        return -1;
+    }
+
+    File seg = LittleFS.open(LITTLEFS_CACHE_SEGMENT_FILE, "a");
+    if (!seg) {
+        Serial.println(F("[CacheMgr] Flush: failed to open segment"));
+        return -1;
+    }
+
+    int flushed = 0;
+    bool ok = true;
+
+    for (int i = 0; i < HOT_SLOT_COUNT && ok; i++) {
+        HotSlot& slot = _hot[i];
+        if (slot.hash == 0 || !slot.dirty) {
+            continue;
+        }
+
+        IndexEntry* entry = findEntry(slot.hash);
+        uint32_t offset;
+        if (entry != nullptr && (entry->flags & ENTRY_FLAG_DIRTY)) {
+            uint8_t recordFlags = ((entry->flags & ENTRY_FLAG_WALLCLOCK) ? RECORD_FLAG_WALLCLOCK : 0) |
+                                  (entry->flags & TYPE_MASK);
+            ok = writeRecord(seg, slot.data, slot.keyLen,
+                             (const uint8_t*)slot.data + slot.keyLen, slot.valueLen,
+                             entry->expiry, entry->written, recordFlags, offset);
+            if (!ok) {
+                break;
+            }
+            entry->offset = offset;
+            entry->flags &= ~ENTRY_FLAG_DIRTY;
+            flushed++;
+        }
+
+        slot.dirty = 0;
+        _dirtyCount--;
+    }
+    seg.close();
+
+    if (!ok) {
+        Serial.println(F("[CacheMgr] Flush FAILED"));
+        return -1;
+    }
+    return flushed;
+}
+
+void CacheManager::setWriteBehind(bool enabled, unsigned long flushIntervalMs, uint8_t maxDirty) {
+    if (!enabled) {
+        flush();
+    }
+    _writeBehind = enabled && HOT_SLOT_COUNT > 0;
+    _flushInterval = flushIntervalMs;
+    _flushDirtyMax = maxDirty > 0 ? maxDirty : 1;
+}
+
+CacheManager::HotStats CacheManager::getHotStats() const {
+    HotStats stats;
+    stats.hits = _hotHits;
+    stats.misses = _hotMisses;
+    stats.slots = HOT_SLOT_COUNT;
+    stats.used = 0;
+    for (int i = 0; i < HOT_SLOT_COUNT; i++) {
+        if (_hot[i].hash != 0) {
+            stats.used++;
+        }
+    }
+    stats.bytes = HOT_SLOT_COUNT * sizeof(HotSlot);
+    return stats;
+}
+
+bool CacheManager::addRevalidateHook(const char* keyPrefix, RevalidateHook hook, void* userData) {
+    if (_hookCount >= LITTLEFS_CACHE_REVALIDATE_HOOKS || hook == nullptr) {
+        Serial.println(F("[CacheMgr] Revalidate hook slots full"));
+        return false;
+    }
+    _hooks[_hookCount].prefix = keyPrefix;
+    _hooks[_hookCount].hook = hook;
+    _hooks[_hookCount].userData = userData;
+    _hookCount++;
+    return true;
+}
+
+bool CacheManager::hasRevalidateHook(const char* key) const {
+    for (int i = 0; i < _hookCount; i++) {
+        const char* prefix = _hooks[i].prefix;
+        if (prefix == nullptr || strncmp(key, prefix, strlen(prefix)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CacheManager::requestRevalidate(uint32_t hash, const char* key) {
+    if (!hasRevalidateHook(key)) {
+        return;
+    }
+
+    // 같은 키 기록이 있으면 재사용, 없으면 빈 슬롯 또는 가장 오래된 처리 완료 슬롯
+    unsigned long now = millis();
+    RevalidateSlot* slot = nullptr;
+    for (int i = 0; i < LITTLEFS_CACHE_REVALIDATE_QUEUE; i++) {
+        RevalidateSlot& candidate = _revalidate[i];
+        if (candidate.hash == hash) {
+            // 화면 갱신마다 getStale()이 불려도 같은 키는 간격을 두고 한 번만
+            if (candidate.pending ||
+                now - candidate.requestedAt < LITTLEFS_CACHE_REVALIDATE_INTERVAL_MS) {
+                return;
+            }
+            slot = &candidate;
+            break;
+        }
+        if (candidate.pending) {
+            continue;
+        }
+        if (slot == nullptr || candidate.hash == 0 ||
+            (slot->hash != 0 && candidate.requestedAt - slot->requestedAt > 0x7FFFFFFFUL)) {
+            slot = &candidate;  // 빈 슬롯 우선, 그다음 가장 오래된 요청
+        }
+    }
+    if (slot == nullptr) {
+        return;  // 모두 대기 중
+    }
+
+    slot->hash = hash;
+    slot->requestedAt = now;
+    slot->pending = true;
+    _revalidatePending++;
+}
+
+void CacheManager::dispatchRevalidate() {
+    // 가장 오래 기다린 요청부터
+    RevalidateSlot* slot = nullptr;
+    for (int i = 0; i < LITTLEFS_CACHE_REVALIDATE_QUEUE; i++) {
+        RevalidateSlot& candidate = _revalidate[i];
+        if (candidate.pending &&
+            (slot == nullptr || candidate.requestedAt - slot->requestedAt > 0x7FFFFFFFUL)) {
+            slot = &candidate;
+        }
+    }
+    if (slot == nullptr) {
+        _revalidatePending = 0;
+        return;
+    }
+    slot->pending = false;
+    _revalidatePending--;
+
+    // 그 사이 갱신/삭제되었으면 건너뜀
+    IndexEntry* entry = findEntry(slot->hash);
+    if (entry == nullptr || freshness(*entry) != STALE) {
+        return;
+    }
+
+    char key[LITTLEFS_MAX_KEY_LEN];
+    File seg;
+    bool found = entryKey(*entry, seg, key);
+    if (seg) {
+        seg.close();
+    }
+    if (!found) {
+        return;
+    }
+
+    for (int i = 0; i < _hookCount; i++) {
+        const char* prefix = _hooks[i].prefix;
+        if (prefix == nullptr || strncmp(key, prefix, strlen(prefix)) == 0) {
+            _hooks[i].hook(key, _hooks[i].userData);
+        }
+    }
+}
+
+bool CacheManager::heapEligible(const IndexEntry& entry) const {
+    if (entry.hash == 0) {
+        return false;
+    }
+    if (_clockSynced) {
+        return (entry.flags & ENTRY_FLAG_WALLCLOCK) != 0;
+    }
+    return (entry.flags & (ENTRY_FLAG_WALLCLOCK | ENTRY_FLAG_PREV_BOOT)) == 0;
+}
+
+void CacheManager::heapSiftUp(uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!expiresBefore(_heap[pos], _heap[parent])) {
+            break;
+        }
+        uint8_t tmp = _heap[pos];
+        _heap[pos] = _heap[parent];
+        _heap[parent] = tmp;
+        _heapPos[_heap[pos]] = pos;
+        _heapPos[_heap[parent]] = parent;
+        pos = parent;
+    }
+}
+
+void CacheManager::heapSiftDown(uint8_t pos) {
+    for (;;) {
+        uint8_t smallest = pos;
+        uint8_t left = pos * 2 + 1;
+        uint8_t right = left + 1;
+        if (left < _heapSize && expiresBefore(_heap[left], _heap[smallest])) {
+            smallest = left;
+        }
+        if (right < _heapSize && expiresBefore(_heap[right], _heap[smallest])) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            break;
+        }
+        uint8_t tmp = _heap[pos];
+        _heap[pos] = _heap[smallest];
+        _heap[smallest] = tmp;
+        _heapPos[_heap[pos]] = pos;
+        _heapPos[_heap[smallest]] = smallest;
+        pos = smallest;
+    }
+}
+
+void CacheManager::heapRemove(uint8_t slot) {
+    uint8_t pos = _heapPos[slot];
+    if (pos == HEAP_NONE) {
+        return;
+    }
+
+    _heapPos[slot] = HEAP_NONE;
+    _heapSize--;
+    if (pos != _heapSize) {
+        // 마지막 항목을 빈 자리로 옮긴 뒤 위/아래 중 필요한 쪽으로 이동
+        _heap[pos] = _heap[_heapSize];
+        _heapPos[_heap[pos]] = pos;
+        if (pos > 0 && expiresBefore(_heap[pos], _heap[(pos - 1) / 2])) {
+            heapSiftUp(pos);
+        } else {
+            heapSiftDown(pos);
+        }
+    }
+}
+
+void CacheManager::heapUpdate(IndexEntry* entry) {
+    uint8_t slot = entry - _index;
+    heapRemove(slot);
+    if (!heapEligible(*entry)) {
+        return;
+    }
+
+    _heap[_heapSize] = slot;
+    _heapPos[slot] = _heapSize;
+    heapSiftUp(_heapSize++);
+}
+
+void CacheManager::heapRebuild() {
+    _heapSize = 0;
+    memset(_heapPos, HEAP_NONE, sizeof(_heapPos));
+    for (uint8_t i = 0; i < LITTLEFS_CACHE_MAX_ENTRIES; i++) {
+        if (heapEligible(_index[i])) {
+            _heap[_heapSize] = i;
+            _heapPos[i] = _heapSize++;
+        }
+    }
+    // Floyd heapify
+    for (int i = _heapSize / 2 - 1; i >= 0; i--) {
+        heapSiftDown(i);
+    }
+}
+
+void CacheManager::removeLegacyFiles() {
+    // 세그먼트 파일 외의 /cache 파일은 모두 이전 포맷이거나 중단된 컴팩션 결과
+    // 순회 중 삭제하면 항목을 건너뛸 수 있으므로 삭제 후 처음부터 다시 순회
+    char fullPath[LITTLEFS_MAX_PATH_LEN];
+    int removed = 0;
+    bool again;
+
+    do {
+        again = false;
+        Dir dir = LittleFS.openDir(LITTLEFS_DIR_CACHE);
+        while (dir.next()) {
+            snprintf(fullPath, sizeof(fullPath), "%s%s", LITTLEFS_CACHE_PREFIX, dir.fileName().c_str());
+            if (strcmp(fullPath, LITTLEFS_CACHE_SEGMENT_FILE) != 0) {
+                again = LittleFS.remove(fullPath);
+                removed++;
+                break;
+            }
+        }
+    } while (again);
+
+    if (removed > 0) {
+        Serial.print(F("[CacheMgr] Removed "));
+        Serial.print(removed);
+        Serial.println(F(" legacy cache files"));
+    }
+}
+
+// --- CacheReader ---
+
+int CacheReader::read() {
+    if (_remaining == 0) {
+        return -1;
+    }
+    int c = _fromRam ? _ram[_size - _remaining] : _file.read();
+    if (c >= 0) {
+        _remaining--;
+    }
+    return c;
+}
+
+int CacheReader::peek() {
+    if (_remaining == 0) {
+        return -1;
+    }
+    return _fromRam ? _ram[_size - _remaining] : _file.peek();
+}
+
+size_t CacheReader::readBytes(char* buffer, size_t length) {
+    if (length > _remaining) {
+        length = _remaining;
+    }
+    if (_fromRam) {
+        memcpy(buffer, _ram + (_size - _remaining), length);
+    } else {
+        length = _file.read((uint8_t*)buffer, length);
+    }
+    _remaining -= length;
+    return length;
+}
+
+void CacheReader::close() {
+    if (_file) {
+        _file.close();
+    }
+    _fromRam = false;
+    _remaining = 0;
+    _size = 0;
+}
+
+// --- CacheWriter ---
+
+size_t CacheWriter::write(const uint8_t* buffer, size_t size) {
+    if (_owner == nullptr || _failed) {
+        return 0;
+    }
+    if (_valueLen + size > LITTLEFS_MAX_CACHE_SIZE) {
+        _failed = true;  // commit()에서 취소됨
+        return 0;
+    }
+
+    size_t written = _file.write(buffer, size);
+    _valueLen += written;
+    if (written != size) {
+        _failed = true;
+    }
+    return written;
+}
+
+bool CacheWriter::commit() {
+    return _owner != nullptr && _owner->commitWrite(*this);
+}
+
+void CacheWriter::abort() {
+    if (_owner != nullptr) {
+        _owner->abortWrite(*this);
+    }
 }
 
 size_t CacheManager::getFreeHeap() const {
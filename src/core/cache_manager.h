@@ -3,23 +3,173 @@
 
 #include <Arduino.h>
 #include <FS.h>
+#include <type_traits>
 #include "arthur_littlefs.h"
 
+class CacheManager;
+
+/**
+ * @brief CacheReader
+ *
+ * 캐시 값 1개를 읽는 Stream (값 길이로 제한됨)
+ * ArduinoJson deserializeJson(doc, reader)로 중간 버퍼 없이 파싱
+ *
+ * @MX:NOTE: hot tier에 있는 값은 reader 내부로 복사, 아니면 세그먼트 파일에서 직접 읽음
+ * 열려 있는 동안 compact()가 실행되면 파일 쪽 값은 이전 세그먼트 기준으로 읽힘
+ */
+class CacheReader : public Stream {
+public:
+    CacheReader() : _fromRam(false), _remaining(0), _size(0) {}
+    ~CacheReader() { close(); }
+
+    int available() override { return (int)_remaining; }
+    int read() override;
+    int peek() override;
+    size_t readBytes(char* buffer, size_t length) override;
+    size_t write(uint8_t) override { return 0; }  // 읽기 전용
+    void flush() override {}
+
+    // 값 전체 길이
+    size_t size() const { return _size; }
+
+    // 파일 닫기 (소멸자에서도 호출)
+    void close();
+
+private:
+    friend class CacheManager;
+
+    File _file;
+    bool _fromRam;         // hot tier 값을 _ram에 복사해 둠 (true면 _file 미사용)
+    size_t _remaining;
+    size_t _size;
+    uint8_t _ram[LITTLEFS_CACHE_HOT_SLOT_SIZE];
+
+    CacheReader(const CacheReader&);
+    CacheReader& operator=(const CacheReader&);
+};
+
+/**
+ * @brief CacheWriter
+ *
+ * 캐시 값 1개를 세그먼트에 직접 기록하는 Print
+ * ArduinoJson serializeJson(doc, writer)로 중간 버퍼 없이 저장, commit()으로 확정
+ *
+ * @MX:WARN: [단일 writer] 열려 있는 동안 다른 세그먼트 기록(set/remove/flush/compact)은 실패함
+ * @MX:REASON: 레코드 헤더를 commit() 때 채우므로 그 사이에 다른 레코드가 끼어들 수 없음
+ */
+class CacheWriter : public Print {
+public:
+    CacheWriter()
+        : _owner(nullptr), _offset(0), _hash(0), _expiry(0), _written(0)
+        , _valueLen(0), _keyLen(0), _clockFlags(0), _failed(false) {}
+    ~CacheWriter() { abort(); }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    /**
+     * @brief 기록 확정 (레코드 헤더 기록 + 인덱스 갱신)
+     *
+     * @return true 성공
+     * @return false 기록 실패 또는 LITTLEFS_MAX_CACHE_SIZE 초과 (이전 값 유지)
+     */
+    bool commit();
+
+    // 기록 취소 (이전 값 유지, 소멸자에서도 호출)
+    void abort();
+
+    bool isOpen() const { return _owner != nullptr; }
+
+    // 지금까지 기록한 값 길이
+    size_t size() const { return _valueLen; }
+
+private:
+    friend class CacheManager;
+
+    CacheManager* _owner;
+    File _file;
+    uint32_t _offset;      // 레코드 시작 위치
+    uint32_t _hash;
+    uint32_t _expiry;
+    uint32_t _written;
+    uint32_t _valueLen;
+    uint8_t _keyLen;
+    uint8_t _clockFlags;   // ENTRY_FLAG_WALLCLOCK 여부
+    bool _failed;
+
+    CacheWriter(const CacheWriter&);
+    CacheWriter& operator=(const CacheWriter&);
+};
+
 /**
  * @brief CacheManager
  *
  * LittleFS 기반 TTL 캐시 관리자
  * - 키-값 저장소
- * - TTL (Time To Live) 기반 만료
+ * - TTL (Time To Live) 기반 만료 (NTP 동기화 후에는 Unix 시각으로 저장되어 재부팅에도 유지)
+ * - 만료 후 stale 기간 동안은 getStale()로 나이와 함께 조회 가능 (재검증 훅 호출)
+ * - 단일 append-only 세그먼트 파일 + RAM 인덱스 (부팅 시 재구성)
+ * - 만료 시각 min-heap: 다음 만료/기한 도래 항목을 플래시 접근 없이 조회
+ * - 작은 값은 RAM hot tier (LRU)에서 바로 응답
+ * - 큰 값은 CacheReader/CacheWriter로 스트리밍 (값 크기의 RAM 버퍼 불필요)
+ * - 숫자/POD 구조체는 타입 태그와 함께 바이너리로 저장 (문자열 변환 없음)
+ * - write-behind 모드 (기본 꺼짐): 작은 값의 set()은 dirty 슬롯만 갱신, flush 시 일괄 기록
+ * - 바이트/항목 수 quota 초과 시 LRU 또는 가장 이른 만료 항목부터 eviction
  * - 정적 할당만 사용 (new/malloc 금지)
  * - String 클래스 미사용 (char[] + F() 매크로)
  *
- * @MX:NOTE: [파일 기반 캐시] 각 캐시 항목은 별도 파일로 저장
+ * @MX:NOTE: [로그 구조 캐시] 모든 항목은 /cache/segment.log 에 레코드로 추가됨
+ * set()은 레코드 1개 append, get()은 seek 1회 + read, has()/getTTL()은 RAM만 사용
+ * 세그먼트가 LITTLEFS_CACHE_COMPACT_THRESHOLD를 넘으면 살아있는 레코드만 복사
+ * @MX:WARN: [write-behind] dirty 값은 flush() 전까지 RAM에만 존재
+ * @MX:REASON: 켜면 loop에서 CacheMgr.update(), 딥슬립/재시작 전에 반드시 CacheMgr.flush() 호출
  * @MX:ANCHOR: [캐시 인터페이스] 모듈 전체에서 데이터 캐싱에 사용
  * @MX:REASON: fan_in >= 3 (WeatherModule, TimeManager 등)
  */
 class CacheManager {
 public:
+    // stale 값 재검증 요청 콜백 (update()에서 호출, 키 갱신은 콜백 쪽 책임)
+    typedef void (*RevalidateHook)(const char* key, void* userData);
+
+    // getTTL() 반환값: NTP 동기화 전이라 남은 시간을 알 수 없음
+    static const long TTL_UNKNOWN = -2;
+
+    // quota 초과 시 eviction 대상 선택 방식
+    enum EvictPolicy {
+        EVICT_LRU,             // 가장 오래 사용되지 않은 항목
+        EVICT_EARLIEST_EXPIRY  // 가장 먼저 만료되는 항목 (만료 인덱스 최상단)
+    };
+
+    // 값 타입 태그 (레코드/인덱스 flags 상위 4비트, 이전 레코드는 0 = 문자열)
+    enum ValueType {
+        TYPE_STRING = 0,
+        TYPE_FLOAT = 1,
+        TYPE_U32 = 2,
+        TYPE_I32 = 3,
+        TYPE_BLOB = 4
+    };
+
+    // hot tier 통계 (예산 산정용)
+    struct HotStats {
+        uint32_t hits;       // RAM에서 응답한 get() 수
+        uint32_t misses;     // 플래시까지 내려간 get() 수
+        uint16_t slots;      // 전체 슬롯 수
+        uint16_t used;       // 사용 중인 슬롯 수
+        size_t bytes;        // 정적 할당된 바이트
+    };
+
+    // 점진적 만료 정리 진행 상황
+    struct SweepStats {
+        uint32_t passes;          // 기한 도래 항목을 모두 비운 sweep() 수
+        uint32_t scanned;         // 처리한 항목 수 (누적)
+        uint32_t expired;         // 만료로 삭제한 항목 수 (누적)
+        uint32_t reclaimedBytes;  // 무효화한 레코드 바이트 (다음 컴팩션에서 회수)
+        uint32_t maxStepMicros;   // 가장 오래 걸린 sweep() 1회 시간
+        uint8_t tracked;          // 만료 인덱스에 등록된 항목 수
+        bool inPass;              // 예산 부족으로 남은 기한 도래 항목 존재
+    };
+
     /**
      * @brief 생성자
      */
@@ -34,7 +184,7 @@ public:
     bool begin();
 
     /**
-     * @brief 캐시에서 값 가져오기
+     * @brief 캐시에서 값 가져오기 (문자열 값만, stale 값 제외)
      *
      * @param key 캐시 키
      * @param outValue 출력 버퍼
@@ -44,6 +194,20 @@ public:
      */
     bool get(const char* key, char* outValue, size_t maxLen);
 
+    /**
+     * @brief 만료된 (stale) 값까지 포함해 가져오기
+     *
+     * stale 값을 반환하면 키 접두사가 일치하는 재검증 훅이 다음 update()에서 호출됨
+     *
+     * @param key 캐시 키
+     * @param outValue 출력 버퍼
+     * @param maxLen 버퍼 크기
+     * @param outAgeMs 저장 후 경과 시간 (밀리초), 알 수 없으면 -1
+     * @return true 값 찾음 (stale 기간 이내)
+     * @return false 값 없음 또는 stale 기간도 지남
+     */
+    bool getStale(const char* key, char* outValue, size_t maxLen, long& outAgeMs);
+
     /**
      * @brief 캐시에 값 저장
      *
@@ -51,10 +215,79 @@ public:
      * @param value 저장할 값
      * @param ttlMillis TTL (밀리초), 0이면 기본값 사용
      * @return true 저장 성공
-     * @return false 저장 실패
+     * @return false 저장 실패 (FNV-1a 해시가 같은 다른 키가 있으면 그 값을 덮어쓰지 않고 실패)
      */
     bool set(const char* key, const char* value, unsigned long ttlMillis = 0);
 
+    /**
+     * @brief float 값 저장/조회 (4바이트 바이너리, 문자열 변환 없음)
+     *
+     * get*()은 없거나 만료되었거나 다른 타입으로 저장된 경우 false
+     */
+    bool setFloat(const char* key, float value, unsigned long ttlMillis = 0) {
+        return setValue(key, (const uint8_t*)&value, sizeof(value), TYPE_FLOAT, ttlMillis);
+    }
+    bool getFloat(const char* key, float& outValue) {
+        return getValue(key, TYPE_FLOAT, &outValue, sizeof(outValue));
+    }
+
+    bool setU32(const char* key, uint32_t value, unsigned long ttlMillis = 0) {
+        return setValue(key, (const uint8_t*)&value, sizeof(value), TYPE_U32, ttlMillis);
+    }
+    bool getU32(const char* key, uint32_t& outValue) {
+        return getValue(key, TYPE_U32, &outValue, sizeof(outValue));
+    }
+
+    bool setI32(const char* key, int32_t value, unsigned long ttlMillis = 0) {
+        return setValue(key, (const uint8_t*)&value, sizeof(value), TYPE_I32, ttlMillis);
+    }
+    bool getI32(const char* key, int32_t& outValue) {
+        return getValue(key, TYPE_I32, &outValue, sizeof(outValue));
+    }
+
+    /**
+     * @brief POD 구조체를 바이너리 그대로 저장
+     *
+     * @MX:WARN: 구조체 레이아웃이 바뀌면 (펌웨어 업데이트) 크기가 다를 때만 감지됨
+     * @MX:REASON: 크기 불일치는 getBlob()에서 false, 같은 크기의 필드 재배치는 감지 불가
+     */
+    template <typename T>
+    bool setBlob(const char* key, const T& value, unsigned long ttlMillis = 0) {
+        static_assert(std::is_trivially_copyable<T>::value, "setBlob requires a trivially copyable type");
+        static_assert(sizeof(T) <= LITTLEFS_MAX_CACHE_SIZE, "blob exceeds LITTLEFS_MAX_CACHE_SIZE");
+        return setValue(key, (const uint8_t*)&value, sizeof(T), TYPE_BLOB, ttlMillis);
+    }
+
+    template <typename T>
+    bool getBlob(const char* key, T& outValue) {
+        static_assert(std::is_trivially_copyable<T>::value, "getBlob requires a trivially copyable type");
+        return getValue(key, TYPE_BLOB, &outValue, sizeof(T));
+    }
+
+    /**
+     * @brief 캐시 값을 Stream으로 열기
+     *
+     * @param key 캐시 키
+     * @param reader 출력 reader (값 길이만큼만 읽힘)
+     * @param outAgeMs nullptr가 아니면 stale 값도 허용하고 나이를 기록 (getStale()과 동일)
+     * @return true 값 찾음
+     * @return false 값 없음 또는 만료됨
+     */
+    bool openRead(const char* key, CacheReader& reader, long* outAgeMs = nullptr);
+
+    /**
+     * @brief 캐시 값을 Print로 기록 시작
+     *
+     * writer.commit() 전까지 기존 값이 유지됨
+     *
+     * @param key 캐시 키
+     * @param writer 출력 writer
+     * @param ttlMillis TTL (밀리초), 0이면 기본값 사용
+     * @return true 기록 시작
+     * @return false 실패 (잘못된 키, 해시 충돌, 인덱스 가득 참, 다른 writer 사용 중)
+     */
+    bool openWrite(const char* key, CacheWriter& writer, unsigned long ttlMillis = 0);
+
     /**
      * @brief 캐시 항목 존재 확인 (만료 체크 포함)
      *
@@ -77,17 +310,74 @@ public:
      * @brief 캐시 항목의 남은 TTL 확인
      *
      * @param key 캐시 키
-     * @return long 남은 TTL (밀리초), -1이면 없음 또는 만료됨
+     * @return long 남은 TTL (밀리초), -1이면 없음 또는 만료됨,
+     *         TTL_UNKNOWN이면 NTP 동기화 전이라 나이를 알 수 없음 (get()은 값을 반환함)
      */
     long getTTL(const char* key);
 
     /**
-     * @brief 모든 만료된 캐시 정리
+     * @brief 모든 만료된 캐시 정리 (한 번에 전체 순회)
+     *
+     * loop에서는 시간 예산이 있는 sweep()/update()를 사용
      *
      * @return int 정리된 항목 수
      */
     int cleanup();
 
+    /**
+     * @brief 만료 항목 점진 정리 (만료 인덱스에서 기한 도래 항목을 만료 순으로 삭제)
+     *
+     * 남은 항목은 인덱스에 그대로 있으므로 다음 호출이 이어서 처리
+     *
+     * @param maxEntries 이번 호출에서 삭제할 최대 항목 수 (0이면 무제한)
+     * @param maxMicros 이번 호출의 최대 시간 (0이면 무제한)
+     * @return true 기한 도래 항목을 모두 처리함
+     * @return false 예산 부족으로 남은 항목 있음
+     */
+    bool sweep(uint8_t maxEntries = LITTLEFS_CACHE_SWEEP_ENTRIES,
+               unsigned long maxMicros = LITTLEFS_CACHE_SWEEP_BUDGET_US);
+
+    /**
+     * @brief update()에서 실행할 sweep 예산 설정
+     *
+     * @param maxEntries 호출당 최대 삭제 항목 수 (0이면 update()에서 sweep 안 함)
+     * @param maxMicros 호출당 최대 시간 (마이크로초)
+     */
+    void setSweepBudget(uint8_t maxEntries, unsigned long maxMicros);
+
+    /**
+     * @brief 다음 항목 만료 (TTL 종료, 이후 stale)까지 남은 시간 (플래시 접근 없음)
+     *
+     * NTP 동기화 전에는 나이를 알 수 없는 항목(이전 부팅)은 제외
+     *
+     * @return long 밀리초, 0이면 이미 만료된 항목 있음, -1이면 만료 예정 항목 없음
+     */
+    long nextExpiryIn();
+
+    /**
+     * @brief 다음 항목 삭제 (만료 + stale 기간)까지 남은 시간 (플래시 접근 없음)
+     *
+     * update()는 이 값이 0일 때만 sweep 실행
+     *
+     * @return long 밀리초, 0이면 이미 삭제 기한 도래 항목 있음, -1이면 대상 항목 없음
+     */
+    long nextRemovalIn();
+
+    /**
+     * @brief 지금부터 withinMs 안에 만료 (TTL 종료)되는 항목 수 (플래시 접근 없음)
+     *
+     * 이미 만료되어 stale 기간에 있는 항목도 포함
+     *
+     * @param withinMs 0이면 이미 만료된 항목만
+     * @return int 항목 수
+     */
+    int countExpiringWithin(unsigned long withinMs);
+
+    /**
+     * @brief 점진적 만료 정리 진행 상황
+     */
+    SweepStats getSweepStats() const;
+
     /**
      * @brief 모든 캐시 비우기
      *
@@ -97,11 +387,118 @@ public:
     bool clear();
 
     /**
-     * @brief 캐시 항목 수 확인
+     * @brief 캐시 항목 수 확인 (O(1))
+     *
+     * @return int 캐시 항목 수 (stale 항목 포함)
+     */
+    int count() const { return _liveCount; }
+
+    /**
+     * @brief 살아있는 레코드의 총 크기 (O(1), 헤더 + 키 + 값)
      *
-     * @return int 캐시 항목 수
+     * @return size_t 바이트
      */
-    int count();
+    size_t bytesUsed() const { return _liveBytes; }
+
+    /**
+     * @brief 용량 제한 설정
+     *
+     * 다음 set()/openWrite() commit 때부터 적용 (이미 초과한 항목을 즉시 지우지 않음)
+     *
+     * @param maxBytes 살아있는 레코드 총 크기 상한
+     * @param maxEntries 항목 수 상한 (LITTLEFS_CACHE_MAX_ENTRIES 이하)
+     * @param policy eviction 대상 선택 방식
+     */
+    void setQuota(size_t maxBytes, uint8_t maxEntries, EvictPolicy policy = EVICT_LRU);
+
+    /**
+     * @brief quota 때문에 삭제된 항목 수 (누적)
+     */
+    uint32_t evictionCount() const { return _evictions; }
+
+    /**
+     * @brief 세그먼트 컴팩션 (살아있는 레코드만 새 세그먼트로 복사)
+     *
+     * 보통 set()/remove()에서 임계값 초과 시 자동 호출됨
+     *
+     * @return true 성공
+     * @return false 실패 (기존 세그먼트 유지)
+     */
+    bool compact();
+
+    /**
+     * @brief 주기 처리 (loop에서 호출)
+     *
+     * write-behind flush 주기 확인, 예산 내에서 만료 항목 점진 정리
+     */
+    void update();
+
+    /**
+     * @brief dirty 값을 세그먼트에 기록 (파일 open 1회)
+     *
+     * 딥슬립/ESP.restart() 전에 호출해야 함
+     *
+     * @return int 기록된 항목 수, -1이면 실패
+     */
+    int flush();
+
+    /**
+     * @brief write-behind 모드 설정
+     *
+     * @param enabled false면 모든 set()이 즉시 기록 (dirty 값은 먼저 flush)
+     * @param flushIntervalMs 첫 dirty 발생 후 flush까지 최대 시간
+     * @param maxDirty dirty 슬롯이 이 수에 도달하면 즉시 flush
+     */
+    void setWriteBehind(bool enabled,
+                        unsigned long flushIntervalMs = LITTLEFS_CACHE_FLUSH_INTERVAL_MS,
+                        uint8_t maxDirty = LITTLEFS_CACHE_FLUSH_DIRTY_MAX);
+
+    /**
+     * @brief 아직 기록되지 않은 dirty 항목 수
+     */
+    int dirtyCount() const { return _dirtyCount; }
+
+    /**
+     * @brief 현재 세그먼트 파일 크기
+     *
+     * @return size_t 세그먼트 크기 (바이트)
+     */
+    size_t segmentSize() const { return _segmentSize; }
+
+    /**
+     * @brief hot tier 적중/실패 통계
+     *
+     * @return HotStats 현재 통계
+     */
+    HotStats getHotStats() const;
+
+    /**
+     * @brief hot tier 적중/실패 카운터 초기화
+     */
+    void resetHotStats() {
+        _hotHits = 0;
+        _hotMisses = 0;
+    }
+
+    /**
+     * @brief 만료 후 삭제까지 stale 값을 유지할 기간
+     *
+     * @param windowMs 0이면 만료 즉시 삭제 (getStale()도 실패)
+     */
+    void setStaleWindow(unsigned long windowMs) {
+        _staleWindow = windowMs > 0x7FFFFFFFUL ? 0x7FFFFFFFUL : windowMs;
+    }
+
+    /**
+     * @brief stale 값 재검증 훅 등록
+     *
+     * @param keyPrefix 대상 키 접두사 (정적 문자열, 예: "weather_"), nullptr면 모든 키
+     * @param hook 콜백
+     * @param userData 콜백에 전달할 포인터
+     * @return true 등록 성공
+     * @return false 훅 슬롯 부족 (LITTLEFS_CACHE_REVALIDATE_HOOKS)
+     */
+    bool addRevalidateHook(const char* keyPrefix, RevalidateHook hook, void* userData);
 
     /**
      * @brief 기본 TTL 설정
@@ -120,23 +517,303 @@ public:
     size_t getFreeHeap() const;
 
 private:
+    friend class CacheWriter;
+
+    // 세그먼트 레코드 헤더 (세그먼트 파일에 그대로 기록, little-endian)
+    // 레이아웃: [헤더 16B][키 keyLen B][값 valueLen B]
+    struct RecordHeader {
+        uint8_t magic;       // RECORD_MAGIC
+        uint8_t flags;       // RECORD_FLAG_* | (ValueType << TYPE_SHIFT)
+        uint8_t keyLen;      // 키 길이 (NUL 제외)
+        uint8_t reserved;
+        uint32_t expiry;     // 만료 시각 (RECORD_FLAG_WALLCLOCK면 Unix 초, 아니면 millis)
+        uint32_t valueLen;   // 값 길이
+        uint32_t written;    // 저장 시각 (expiry와 같은 단위, stale 값의 나이 계산용)
+    };
+    static_assert(sizeof(RecordHeader) == 16, "RecordHeader is stored on flash as-is");
+
+    // RAM 인덱스 항목 (키 문자열은 보관하지 않고 해시만 보관)
+    // 해시가 같은 다른 키는 findKey()가 hot 슬롯/레코드의 키와 비교해 구분하고,
+    // 쓰기는 거부함 - 한 해시에 살아있는 키는 항상 하나
+    struct IndexEntry {
+        uint32_t hash;       // 키 FNV-1a 해시 (0 = 빈 슬롯)
+        uint32_t offset;     // 세그먼트 내 레코드 시작 위치
+        uint32_t expiry;     // 만료 시각 (ENTRY_FLAG_WALLCLOCK면 Unix 초, 아니면 millis)
+        uint32_t written;    // 저장 시각 (expiry와 같은 단위)
+        uint32_t lastUse;    // LRU 틱 (eviction용)
+        uint16_t valueLen;   // 값 길이
+        uint8_t keyLen;      // 키 길이
+        uint8_t flags;       // ENTRY_FLAG_* | (ValueType << TYPE_SHIFT)
+    };
+
+    // hot tier 슬롯: data = [키 keyLen B][값 valueLen B]
+    struct HotSlot {
+        uint32_t hash;       // 키 해시 (0 = 빈 슬롯)
+        uint32_t lastUse;    // LRU 틱
+        uint16_t valueLen;
+        uint8_t keyLen;
+        uint8_t dirty;       // 1이면 세그먼트에 아직 기록되지 않음 (eviction 금지)
+        char data[LITTLEFS_CACHE_HOT_SLOT_SIZE];
+    };
+
+    static const int HOT_SLOT_COUNT = LITTLEFS_CACHE_HOT_BYTES / sizeof(HotSlot);
+    static const uint8_t ENTRY_FLAG_DIRTY = 0x01;        // 값이 hot 슬롯에만 있음 (offset 무효)
+    static const uint8_t ENTRY_FLAG_WALLCLOCK = 0x02;    // expiry가 Unix 초
+    static const uint8_t ENTRY_FLAG_PREV_BOOT = 0x04;    // 이전 부팅의 millis expiry (나이 불명)
+    static const uint8_t ENTRY_FLAG_AGE_UNKNOWN = 0x08;  // 동기화 시 재계산 불가했던 항목
+    static const uint8_t TYPE_SHIFT = 4;                 // ValueType 위치 (엔트리/레코드 flags 공통)
+    static const uint8_t TYPE_MASK = 0xF0;
+    static const uint8_t HEAP_NONE = 0xFF;               // _heapPos: heap에 없음
+    static_assert(LITTLEFS_CACHE_MAX_ENTRIES < HEAP_NONE, "heap positions are stored in uint8_t");
+
+    // 만료 판정 결과
+    enum Freshness {
+        FRESH,
+        STALE,           // 만료됐지만 stale 기간 이내 - getStale()만 반환
+        EXPIRED,         // stale 기간도 지남 - 삭제 대상
+        UNKNOWN_AGE      // NTP 동기화 전이라 판단 불가 - 값은 반환
+    };
+
+    static const uint32_t SEGMENT_MAGIC = 0x324C4341;  // "ACL2" (ACL1은 written 필드 없음)
+    static const uint8_t RECORD_MAGIC = 0xA5;
+    static const uint8_t RECORD_FLAG_TOMBSTONE = 0x01;
+    static const uint8_t RECORD_FLAG_WALLCLOCK = 0x02;
+
     bool _mounted;
     unsigned long _defaultTTL;
 
-    // 키로 파일 경로 생성
-    void getFilePath(const char* key, char* outPath, size_t maxLen);
+    IndexEntry _index[LITTLEFS_CACHE_MAX_ENTRIES];
+    size_t _segmentSize;   // 유효한 세그먼트 끝 위치
+    size_t _deadBytes;     // 덮어쓰기/삭제로 무효화된 바이트 (컴팩션 대상)
+    size_t _liveBytes;     // 살아있는 항목의 레코드 크기 합 (dirty 포함)
+    int _liveCount;
+    uint32_t _lruTick;
+
+    size_t _quotaBytes;
+    uint8_t _quotaEntries;
+    EvictPolicy _evictPolicy;
+    uint32_t _evictions;
+
+    HotSlot _hot[HOT_SLOT_COUNT > 0 ? HOT_SLOT_COUNT : 1];
+    uint32_t _hotTick;
+    uint32_t _hotHits;
+    uint32_t _hotMisses;
+
+    bool _writeBehind;
+    uint8_t _flushDirtyMax;
+    int _dirtyCount;
+    unsigned long _flushInterval;
+    unsigned long _dirtySince;   // 첫 dirty 발생 시각 (millis)
+
+    bool _clockSynced;           // millis expiry를 Unix 시각으로 재계산했는지
+    bool _tornTail;              // 잘라내지 못한 부분 기록이 세그먼트 끝에 남음 (컴팩션 필요)
 
-    // 메타데이터 파일 경로 생성
-    void getMetaPath(const char* key, char* outPath, size_t maxLen);
+    CacheWriter* _writer;        // 진행 중인 스트리밍 기록 (세그먼트 끝을 점유)
 
-    // 만료 시간 계산
-    unsigned long getExpiryTime(unsigned long ttlMillis);
+    unsigned long _staleWindow;  // 만료 후 삭제까지 (밀리초)
+
+    struct RevalidateHookSlot {
+        const char* prefix;
+        RevalidateHook hook;
+        void* userData;
+    };
+    RevalidateHookSlot _hooks[LITTLEFS_CACHE_REVALIDATE_HOOKS];
+    uint8_t _hookCount;
+    // 재검증 요청 기록 (처리 후에도 남겨 같은 키의 반복 요청 억제)
+    struct RevalidateSlot {
+        uint32_t hash;               // 0 = 빈 슬롯
+        unsigned long requestedAt;   // millis
+        bool pending;                // update()에서 훅 호출 대기
+    };
+    RevalidateSlot _revalidate[LITTLEFS_CACHE_REVALIDATE_QUEUE];
+    uint8_t _revalidatePending;
+
+    // 만료 시각 min-heap (인덱스 슬롯 번호 저장, _heapPos는 슬롯 -> heap 위치)
+    // 현재 시계 기준으로 판정 가능한 항목만 등록: 동기화 전에는 이번 부팅의 millis 항목,
+    // 동기화 후에는 Unix 시각 항목 (동기화 시 재구성)
+    uint8_t _heap[LITTLEFS_CACHE_MAX_ENTRIES];
+    uint8_t _heapPos[LITTLEFS_CACHE_MAX_ENTRIES];
+    uint8_t _heapSize;
+
+    uint8_t _sweepEntries;
+    unsigned long _sweepMicros;
+    SweepStats _sweepStats;
+
+    // 만료 시간 계산 (동기화 후에는 Unix 초, outFlags에 ENTRY_FLAG_WALLCLOCK 설정)
+    uint32_t getExpiryTime(unsigned long ttlMillis, uint8_t& outFlags, uint32_t& outWritten);
+
+    // NTP 동기화 여부 확인, 최초 동기화 시 인덱스의 millis expiry를 Unix 시각으로 변환
+    bool clockSynced();
 
     // LittleFS 마운트 (내부 사용)
     bool mount();
 
-    // 만료 체크
-    bool isExpired(const char* key);
+    // 만료 판정
+    Freshness freshness(const IndexEntry& entry);
+
+    // 삭제 대상 체크 (STALE/UNKNOWN_AGE는 아님)
+    bool isExpired(const IndexEntry& entry) {
+        return freshness(entry) == EXPIRED;
+    }
+
+    // 저장 후 경과 시간 (밀리초), 알 수 없으면 -1
+    long entryAge(const IndexEntry& entry);
+
+    // 삭제 기한 (만료 + stale 기간, expiry와 같은 단위)
+    uint32_t removalTime(const IndexEntry& entry) const;
+
+    // heap 최상단 항목의 만료 (removal이면 삭제) 기한까지 남은 시간
+    long nextDeadlineIn(bool removal);
+
+    // 조회 가능 여부 확인 (EXPIRED면 삭제, outAgeMs가 있으면 stale 허용 + 재검증 요청)
+    bool checkEntry(IndexEntry* entry, const char* key, long* outAgeMs);
+
+    // stale 값 재검증 요청 (훅 접두사와 일치하는 키만, update()에서 훅 호출)
+    void requestRevalidate(uint32_t hash, const char* key);
+
+    // 키에 해당하는 재검증 훅이 있는지
+    bool hasRevalidateHook(const char* key) const;
+    void dispatchRevalidate();
+
+    // 키 해시 (FNV-1a, 0은 빈 슬롯 표시로 예약)
+    static uint32_t hashKey(const char* key);
+
+    // 인덱스 검색 (없으면 nullptr)
+    IndexEntry* findEntry(uint32_t hash);
+
+    // 인덱스 검색 + 저장된 키 비교 (해시가 같은 다른 키면 nullptr, outCollision = true)
+    IndexEntry* findKey(uint32_t hash, const char* key, size_t keyLen, bool& outCollision);
+
+    // 빈 인덱스 슬롯 (없으면 nullptr)
+    IndexEntry* allocEntry();
+
+    // 사용량 집계 (항목 추가/제거 시 호출)
+    void usageAdd(const IndexEntry& entry) {
+        _liveBytes += recordSize(entry.keyLen, entry.valueLen);
+        _liveCount++;
+    }
+    void usageRemove(const IndexEntry& entry) {
+        _liveBytes -= recordSize(entry.keyLen, entry.valueLen);
+        _liveCount--;
+    }
+
+    // LRU 틱 갱신
+    void touch(IndexEntry* entry) {
+        entry->lastUse = ++_lruTick;
+    }
+
+    // hash 키에 newSize 바이트 레코드를 넣을 수 있도록 다른 항목 evict
+    bool makeRoom(uint32_t hash, size_t newSize);
+
+    // eviction 대상 (protectHash 제외, 없으면 nullptr)
+    IndexEntry* evictionVictim(uint32_t protectHash);
+
+    // 레코드 전체 크기 (헤더 + 키 + 값)
+    static size_t recordSize(uint8_t keyLen, size_t valueLen) {
+        return sizeof(RecordHeader) + keyLen + valueLen;
+    }
+
+    // 열린 세그먼트에 레코드 기록, 성공 시 레코드 시작 위치 반환
+    bool writeRecord(File& seg, const char* key, uint8_t keyLen, const uint8_t* value,
+                     size_t valueLen, uint32_t expiry, uint32_t written, uint8_t flags,
+                     uint32_t& outOffset);
+
+    // 세그먼트를 열어 레코드 1개 추가
+    bool appendRecord(const char* key, uint8_t keyLen, const uint8_t* value,
+                      size_t valueLen, uint32_t expiry, uint32_t written, uint8_t flags,
+                      uint32_t& outOffset);
+
+    // 덮어쓰기 직전 기존 항목의 레코드/사용량 정리 (빈 항목이면 무시)
+    void releaseRecord(IndexEntry& entry);
+
+    // 인덱스 항목의 키 복원 (hot 슬롯 또는 세그먼트 레코드에서, seg는 필요 시 열림)
+    bool entryKey(const IndexEntry& entry, File& seg, char* outKey);
+
+    // 항목의 값 타입
+    static uint8_t entryType(const IndexEntry& entry) {
+        return (entry.flags & TYPE_MASK) >> TYPE_SHIFT;
+    }
+
+    // 값 저장 (set()과 typed setter 공통)
+    bool setValue(const char* key, const uint8_t* value, size_t valueLen,
+                  uint8_t type, unsigned long ttlMillis);
+
+    // 값 읽기 (타입 확인, 문자열이 아니면 크기가 maxLen과 정확히 같아야 함)
+    bool readValue(const char* key, uint8_t type, uint8_t* out, size_t maxLen, size_t& outLen,
+                   long* outAgeMs);
+
+    // 고정 크기 값 읽기
+    bool getValue(const char* key, uint8_t type, void* out, size_t size);
+
+    // 세그먼트를 열어 레코드 키 확인 후 값 시작 위치로 이동 (해시 충돌 방지)
+    bool openRecord(const IndexEntry& entry, const char* key, File& seg);
+
+    // 인덱스 항목 삭제 (tombstone 기록 포함)
+    bool removeEntry(IndexEntry* entry, const char* key, uint8_t keyLen);
+
+    // 만료된 항목이면 삭제 (sweep 통계 갱신, seg는 키 복원에 필요 시 열림)
+    bool expireEntry(IndexEntry& entry, File& seg);
+
+    // 스트리밍 기록 중이면 세그먼트 기록 불가
+    bool segmentBusy() const;
+
+    // CacheWriter 확정/취소
+    bool commitWrite(CacheWriter& writer);
+    void abortWrite(CacheWriter& writer);
+
+    // 인덱스에 넣지 못한 스트리밍 레코드를 tombstone으로 무효화 (키 삭제)
+    void discardRecord(const CacheWriter& writer);
+
+    // 빈 세그먼트 생성
+    bool createSegment();
+
+    // 세그먼트 스캔으로 RAM 인덱스 재구성
+    bool rebuildIndex();
+
+    // dirty 슬롯을 세그먼트에 기록 (컴팩션 없음), 기록 수 또는 -1 반환
+    int writeDirty();
+
+    // 무효 바이트가 많으면 컴팩션
+    void maybeCompact();
+
+    // 부분 기록이 남아 있으면 컴팩션으로 제거 (append 가능 상태면 true)
+    bool repairTail();
+
+    // hot tier 검색 (키 일치 확인 포함, 없으면 nullptr)
+    HotSlot* hotFind(uint32_t hash, const char* key, size_t keyLen);
+
+    // 해시로 hot 슬롯 검색 (키 확인 없음)
+    HotSlot* hotSlotFor(uint32_t hash);
+
+    // hot tier에 값 저장, dirty면 eviction 대상에서 제외 (슬롯 부족 시 false)
+    bool hotPut(uint32_t hash, const char* key, size_t keyLen,
+                const char* value, size_t valueLen, bool dirty);
+
+    // hot tier에서 키 제거 (dirty 값은 버려짐)
+    void hotDrop(uint32_t hash);
+
+    // 현재 시계 기준으로 만료 판정 가능한지 (heap 등록 대상)
+    bool heapEligible(const IndexEntry& entry) const;
+
+    // a가 b보다 먼저 만료되는지 (같은 시계 기준 항목끼리만 비교)
+    bool expiresBefore(uint8_t a, uint8_t b) const {
+        return (int32_t)(_index[a].expiry - _index[b].expiry) < 0;
+    }
+
+    // 항목의 heap 위치 갱신 (대상이 아니면 제거)
+    void heapUpdate(IndexEntry* entry);
+
+    // heap에서 슬롯 제거
+    void heapRemove(uint8_t slot);
+
+    // 인덱스 전체로 heap 재구성
+    void heapRebuild();
+
+    void heapSiftUp(uint8_t pos);
+    void heapSiftDown(uint8_t pos);
+
+    // 1.x 포맷 (/cache/{key} + /cache/.{key}.meta) 잔여 파일 삭제
+    void removeLegacyFiles();
 };
 
 // 전역 인스턴스
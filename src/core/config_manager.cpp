@@ -1,17 +1,29 @@
 #include "config_manager.h"
+#include "event_bus.h"
 #include <LittleFS.h>
 #include <ArduinoJson.h>
 
 // 전역 인스턴스
 ConfigManager ConfigMgr;
 
+static_assert(Cfg::KEY_COUNT <= 32, "_pendingChanges bitmask holds 32 keys");
+
 // @MX:ANCHOR: [설정 관리자 초기화] 부팅 시 첫 호출점
 // @MX:REASON: 시스템 진입점, begin()에서 마운트 및 설정 로드
 ConfigManager::ConfigManager()
     : _mounted(false)
     , _dirty(false)
     , _loaded(false)
+    , _inTransaction(false)
+    , _lastChange(0)
+    , _pendingChanges(0)
+    , _txPendingChanges(0)
+    , _activeSlot(SLOT_NONE)
+    , _generation(0)
+    , _entryCount(0)
+    , _poolUsed(0)
 {
+    memset(_schemaIndex, SCHEMA_NONE, sizeof(_schemaIndex));
 }
 
 bool ConfigManager::begin() {
@@ -94,177 +106,790 @@ bool ConfigManager::ensureDirectories() {
     return true;
 }
 
-bool ConfigManager::load() {
-    File file = LittleFS.open(LITTLEFS_CONFIG_FILE, "r");
+// CRC-32 (IEEE, 테이블 없이 비트 단위 - 설정은 1KB 이하라 속도보다 RAM/플래시 우선)
+static uint32_t crc32Update(uint32_t crc, uint8_t data) {
+    crc ^= data;
+    for (int bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+    }
+    return crc;
+}
+
+/**
+ * @brief 슬롯 payload를 읽으면서 CRC 계산 (파서에 직접 연결, 중간 버퍼 없음)
+ */
+class SlotReader : public Stream {
+public:
+    SlotReader(File& file, size_t length)
+        : _file(file), _remaining(length), _crc(0xFFFFFFFFUL) {}
+
+    int available() override { return (int)_remaining; }
+    int peek() override { return _remaining > 0 ? _file.peek() : -1; }
+    size_t write(uint8_t) override { return 0; }
+
+    int read() override {
+        if (_remaining == 0) {
+            return -1;
+        }
+        int c = _file.read();
+        if (c < 0) {
+            _remaining = 0;  // 파일이 헤더 길이보다 짧음 - CRC 불일치로 처리됨
+            return -1;
+        }
+        _remaining--;
+        _crc = crc32Update(_crc, (uint8_t)c);
+        return c;
+    }
+
+    size_t readBytes(char* buffer, size_t length) override {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0) {
+                break;
+            }
+            buffer[count++] = (char)c;
+        }
+        return count;
+    }
+
+    // 파서가 읽지 않은 나머지도 CRC에 포함 후 최종 값
+    uint32_t finish() {
+        while (read() >= 0) {
+        }
+        return ~_crc;
+    }
+
+private:
+    File& _file;
+    size_t _remaining;
+    uint32_t _crc;
+};
+
+/**
+ * @brief 슬롯 payload를 기록하면서 길이/CRC 계산
+ */
+class SlotWriter : public Print {
+public:
+    explicit SlotWriter(File& file) : _file(file), _length(0), _crc(0xFFFFFFFFUL) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        size_t written = _file.write(buffer, size);
+        for (size_t i = 0; i < written; i++) {
+            _crc = crc32Update(_crc, buffer[i]);
+        }
+        _length += written;
+        return written;
+    }
+    using Print::write;
+
+    size_t length() const { return _length; }
+    uint32_t crc() const { return ~_crc; }
+
+private:
+    File& _file;
+    size_t _length;
+    uint32_t _crc;
+};
+
+static const char* slotPath(uint8_t slot) {
+    return slot == 0 ? LITTLEFS_CONFIG_SLOT_A_FILE : LITTLEFS_CONFIG_SLOT_B_FILE;
+}
+
+bool ConfigManager::readSlotHeader(uint8_t slot, SlotHeader& hdr) {
+    File file = LittleFS.open(slotPath(slot), "r");
+    if (!file) {
+        return false;
+    }
+    bool ok = file.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr);
+    file.close();
+
+    return ok && hdr.magic == SLOT_MAGIC && hdr.length > 0 && hdr.length <= SLOT_MAX_PAYLOAD;
+}
+
+template <typename TDocument>
+bool ConfigManager::readSlot(uint8_t slot, const SlotHeader& hdr, TDocument& doc) {
+    File file = LittleFS.open(slotPath(slot), "r");
     if (!file) {
-        // 파일 없음 = 첫 부팅
         return false;
     }
+    file.seek(sizeof(SlotHeader));
+
+    SlotReader reader(file, hdr.length);
+    DeserializationError error = (hdr.format == SLOT_FORMAT_MSGPACK)
+                                 ? deserializeMsgPack(doc, reader)
+                                 : deserializeJson(doc, reader);
+    uint32_t crc = reader.finish();
+    file.close();
+
+    if (error || crc != hdr.crc) {
+        Serial.print(F("[ConfigMgr] Slot "));
+        Serial.print((char)('A' + slot));
+        Serial.println(F(" invalid, ignored"));
+        return false;
+    }
+    return true;
+}
 
-    // JSON 문서 파싱
+bool ConfigManager::load() {
+    // 문서 파싱 (부팅 시 1회만, 이후 조회는 RAM 테이블 사용)
     StaticJsonDocument<JSON_DOC_SIZE> doc;
 
-    // deserializeJson의 DeserializationError 반환
-    DeserializationError error = deserializeJson(doc, file);
+    // @MX:NOTE: [A/B 슬롯] 헤더 2개만 읽고 세대가 높은 슬롯부터 payload를 1회 스트리밍 파싱
+    // CRC가 맞지 않으면 (기록 중 전원 차단) 이전 세대 슬롯 사용 - 삭제/rename 복구 단계 없음
+    SlotHeader headers[2];
+    bool valid[2];
+    for (uint8_t slot = 0; slot < 2; slot++) {
+        valid[slot] = readSlotHeader(slot, headers[slot]);
+    }
+
+    uint8_t newest = 0;
+    if (valid[0] && valid[1]) {
+        // 세대 비교 (wrap-around 안전)
+        newest = ((int32_t)(headers[1].generation - headers[0].generation) > 0) ? 1 : 0;
+    } else if (valid[1]) {
+        newest = 1;
+    }
+
+    for (uint8_t i = 0; i < 2; i++) {
+        uint8_t slot = (i == 0) ? newest : (uint8_t)(1 - newest);
+        if (valid[slot] && readSlot(slot, headers[slot], doc)) {
+            applyDocument(doc);
+            _activeSlot = slot;
+            _generation = headers[slot].generation;
+            return true;
+        }
+    }
+
+    return migrateLegacy(doc);
+}
+
+template <typename TDocument>
+bool ConfigManager::migrateLegacy(TDocument& doc) {
+    // @MX:NOTE: [마이그레이션] 이전 단일 파일 형식 (device.mpk, device.json)을 슬롯으로 변환
+    // 슬롯 기록이 성공한 뒤에만 이전 파일 삭제
+    const char* path = LITTLEFS_CONFIG_BIN_FILE;
+    File file = LittleFS.open(path, "r");
+    DeserializationError error;
+    if (file) {
+        error = deserializeMsgPack(doc, file);
+    } else {
+        path = LITTLEFS_CONFIG_FILE;
+        file = LittleFS.open(path, "r");
+        if (!file) {
+            // 파일 없음 = 첫 부팅
+            return false;
+        }
+        error = deserializeJson(doc, file);
+    }
     file.close();
 
     if (error) {
-        Serial.print(F("[ConfigMgr] JSON parse error: "));
+        Serial.print(F("[ConfigMgr] Legacy config parse error: "));
         Serial.println(error.f_str());
         return false;
     }
 
-    // 성공적으로 로드됨
-    // 내부적으로 doc의 내용은 get() 호출 시 사용됨
-    // 여기서는 별도 캐싱하지 않고 필요시 파일에서 다시 읽거나,
-    // 더 나은 방법은 JSON 문서를 멤버 변수로 보관하는 것
+    applyDocument(doc);
+    _dirty = true;
+    if (save()) {
+        LittleFS.remove(path);
+        Serial.print(F("[ConfigMgr] Migrated "));
+        Serial.println(path);
+    }
+    return true;
+}
+
+template <typename TDocument>
+void ConfigManager::applyDocument(TDocument& doc) {
+    // @MX:NOTE: [메모리 최적화] 문서는 보관하지 않고 타입별 값만 RAM 테이블로 복사
+    // (1KB 문서 대신 항목당 16바이트 + 문자열 풀)
+    clearEntries();
+    for (JsonPair kv : doc.template as<JsonObject>()) {
+        const char* key = kv.key().c_str();
+        JsonVariant value = kv.value();
+        bool ok;
+
+        if (value.template is<bool>()) {
+            ok = setBool(key, value.template as<bool>());
+        } else if (value.template is<int>()) {
+            ok = setInt(key, value.template as<int>());
+        } else if (value.template is<const char*>()) {
+            ok = set(key, value.template as<const char*>());
+        } else {
+            ok = false;
+        }
 
-    // @MX:NOTE: [메모리 최적화] JSON 문서를 멤버로 보관하지 않음
-    // 필요할 때마다 파일에서 읽어서 메모리 절약 ( trade-off: 성능 vs 메모리)
+        if (!ok) {
+            Serial.print(F("[ConfigMgr] Skipped key: "));
+            Serial.println(key);
+        }
+    }
 
     _loaded = true;
     _dirty = false;
-    return true;
+    _pendingChanges = 0;  // 파일에서 읽은 값은 변경 알림 대상 아님
 }
 
-bool ConfigManager::get(const char* key, char* outValue, size_t maxLen, const char* defaultValue) {
-    if (!_loaded && !load()) {
-        // 로드 실패 시 기본값 사용
-        strncpy(outValue, defaultValue, maxLen - 1);
-        outValue[maxLen - 1] = '\0';
-        return false;
+template <typename TDocument>
+bool ConfigManager::buildDocument(TDocument& doc) const {
+    for (uint8_t i = 0; i < _entryCount; i++) {
+        const Entry& entry = _entries[i];
+        const char* key = _pool + entry.keyOffset;
+        if (entry.type == TYPE_STRING) {
+            doc[key] = (const char*)(_pool + entry.strOffset);
+        } else if (entry.type == TYPE_BOOL) {
+            doc[key] = entry.intValue != 0;
+        } else {
+            doc[key] = entry.intValue;
+        }
     }
 
-    File file = LittleFS.open(LITTLEFS_CONFIG_FILE, "r");
-    if (!file) {
-        strncpy(outValue, defaultValue, maxLen - 1);
-        outValue[maxLen - 1] = '\0';
+    if (doc.overflowed()) {
+        Serial.println(F("[ConfigMgr] Config too large for JSON document"));
         return false;
     }
+    return true;
+}
 
-    StaticJsonDocument<JSON_DOC_SIZE> doc;
-    DeserializationError error = deserializeJson(doc, file);
-    file.close();
+uint32_t ConfigManager::hashKey(const char* key) {
+    // FNV-1a 32비트
+    uint32_t hash = 2166136261UL;
+    while (*key) {
+        hash ^= (uint8_t)*key++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
 
-    if (error) {
-        strncpy(outValue, defaultValue, maxLen - 1);
-        outValue[maxLen - 1] = '\0';
+const ConfigManager::Entry* ConfigManager::findEntry(const char* key) const {
+    uint32_t hash = hashKey(key);
+    for (uint8_t i = 0; i < _entryCount; i++) {
+        // 해시가 같을 때만 키 비교 (충돌 대비)
+        if (_entries[i].hash == hash && strcmp(_pool + _entries[i].keyOffset, key) == 0) {
+            return &_entries[i];
+        }
+    }
+    return nullptr;
+}
+
+ConfigManager::Entry* ConfigManager::findOrCreate(const char* key, bool& outCreated) {
+    outCreated = false;
+    Entry* entry = const_cast<Entry*>(findEntry(key));
+    if (entry != nullptr) {
+        return entry;
+    }
+
+    if (strlen(key) >= MAX_KEY_LEN || _entryCount >= MAX_ENTRIES) {
+        Serial.print(F("[ConfigMgr] Cannot add key: "));
+        Serial.println(key);
+        return nullptr;
+    }
+
+    uint16_t keyOffset;
+    if (!poolAdd(key, keyOffset)) {
+        return nullptr;
+    }
+
+    entry = &_entries[_entryCount];
+    entry->hash = hashKey(key);
+    entry->intValue = 0;
+    entry->keyOffset = keyOffset;
+    entry->strOffset = 0;
+    entry->type = TYPE_INT;
+    entry->schemaId = SCHEMA_NONE;
+
+    // 스키마 키면 ID -> 항목 연결 (문자열 비교는 항목 생성 시 1회만)
+    for (uint8_t id = 0; id < Cfg::KEY_COUNT; id++) {
+        if (strcmp_P(key, (const char*)pgm_read_ptr(&Cfg::SCHEMA[id].name)) == 0) {
+            entry->schemaId = id;
+            _schemaIndex[id] = _entryCount;
+            break;
+        }
+    }
+
+    _entryCount++;
+    outCreated = true;
+    return entry;
+}
+
+void ConfigManager::dropLastEntry() {
+    // 방금 추가한 항목 취소 (키 문자열은 압축 때 회수)
+    _entryCount--;
+    uint8_t schemaId = _entries[_entryCount].schemaId;
+    if (schemaId != SCHEMA_NONE) {
+        _schemaIndex[schemaId] = SCHEMA_NONE;
+    }
+}
+
+bool ConfigManager::poolAdd(const char* str, uint16_t& outOffset) {
+    size_t len = strlen(str) + 1;
+    if (_poolUsed + len > STRING_POOL_SIZE) {
+        poolCompact();
+        if (_poolUsed + len > STRING_POOL_SIZE) {
+            Serial.println(F("[ConfigMgr] String pool full"));
+            return false;
+        }
+    }
+
+    memcpy(_pool + _poolUsed, str, len);
+    outOffset = (uint16_t)_poolUsed;
+    _poolUsed += len;
+    return true;
+}
+
+void ConfigManager::poolCompact() {
+    // 참조 중인 문자열을 오프셋 순서대로 앞으로 당김 (항목 수가 적어 O(n^2) 허용)
+    size_t used = 0;
+    size_t from = 0;
+    while (true) {
+        uint16_t* next = nullptr;
+        for (uint8_t i = 0; i < _entryCount; i++) {
+            Entry& entry = _entries[i];
+            if (entry.keyOffset >= from && (next == nullptr || entry.keyOffset < *next)) {
+                next = &entry.keyOffset;
+            }
+            if (entry.type == TYPE_STRING && entry.strOffset >= from &&
+                (next == nullptr || entry.strOffset < *next)) {
+                next = &entry.strOffset;
+            }
+        }
+        if (next == nullptr) {
+            break;
+        }
+
+        size_t len = strlen(_pool + *next) + 1;
+        from = *next + 1;
+        memmove(_pool + used, _pool + *next, len);
+        *next = (uint16_t)used;
+        used += len;
+    }
+    _poolUsed = used;
+}
+
+void ConfigManager::markDirty(uint8_t schemaId) {
+    _dirty = true;
+    _lastChange = millis();
+    if (schemaId != SCHEMA_NONE) {
+        _pendingChanges |= (1UL << schemaId);
+    }
+}
+
+void ConfigManager::publishChanges() {
+    for (uint8_t id = 0; id < Cfg::KEY_COUNT && _pendingChanges != 0; id++) {
+        uint32_t bit = 1UL << id;
+        if (!(_pendingChanges & bit)) {
+            continue;
+        }
+
+        if (!gEventBus.publish(CONFIG_CHANGED, (Cfg::Id)id)) {
+            return;  // 큐 가득 참 - 남은 키는 다음 update()에서 재시도
+        }
+        _pendingChanges &= ~bit;
+    }
+}
+
+Cfg::Id ConfigManager::changedKey(const Event& event) {
+    const Cfg::Id* id = event.as<Cfg::Id>();
+    return (id != nullptr) ? *id : Cfg::KEY_COUNT;
+}
+
+void ConfigManager::clearEntries() {
+    _entryCount = 0;
+    _poolUsed = 0;
+    memset(_schemaIndex, SCHEMA_NONE, sizeof(_schemaIndex));
+}
+
+// true/"1"/"yes" 판별 (그 외는 defaultValue)
+static bool parseBool(const char* str, bool defaultValue) {
+    if (strcmp(str, "true") == 0 ||
+        strcmp(str, "1") == 0 ||
+        strcmp(str, "yes") == 0 ||
+        strcmp(str, "YES") == 0) {
+        return true;
+    }
+    if (strcmp(str, "false") == 0 ||
+        strcmp(str, "0") == 0 ||
+        strcmp(str, "no") == 0 ||
+        strcmp(str, "NO") == 0) {
         return false;
     }
+    return defaultValue;
+}
 
-    // 키로 값 검색
-    JsonVariant value = doc[key];
-    if (!value.is<const char*>()) {
+bool ConfigManager::get(const char* key, char* outValue, size_t maxLen, const char* defaultValue) {
+    const Entry* entry = findEntry(key);
+    if (entry == nullptr) {
         strncpy(outValue, defaultValue, maxLen - 1);
         outValue[maxLen - 1] = '\0';
         return false;
     }
 
-    const char* strValue = value.as<const char*>();
+    // 숫자/불리언 값도 문자열로 반환 (파일 형식과 무관하게 동일 동작)
+    char numBuf[16];
+    const char* strValue;
+    if (entry->type == TYPE_STRING) {
+        strValue = _pool + entry->strOffset;
+    } else if (entry->type == TYPE_BOOL) {
+        strValue = entry->intValue ? "true" : "false";
+    } else {
+        strValue = itoa(entry->intValue, numBuf, 10);
+    }
+
     strncpy(outValue, strValue, maxLen - 1);
     outValue[maxLen - 1] = '\0';
     return true;
 }
 
 int ConfigManager::getInt(const char* key, int defaultValue) {
-    char buf[MAX_VALUE_STR_LEN];
-    if (get(key, buf, sizeof(buf), "")) {
-        return atoi(buf);
+    const Entry* entry = findEntry(key);
+    if (entry == nullptr) {
+        return defaultValue;
     }
-    return defaultValue;
+    if (entry->type == TYPE_STRING) {
+        return atoi(_pool + entry->strOffset);  // 이전 형식 ("123")
+    }
+    return entry->intValue;
 }
 
 bool ConfigManager::getBool(const char* key, bool defaultValue) {
-    char buf[MAX_VALUE_STR_LEN];
-    if (get(key, buf, sizeof(buf), "")) {
-        // true/"1"/"yes" 판별
-        if (strcmp(buf, "true") == 0 ||
-            strcmp(buf, "1") == 0 ||
-            strcmp(buf, "yes") == 0 ||
-            strcmp(buf, "YES") == 0) {
-            return true;
+    const Entry* entry = findEntry(key);
+    if (entry == nullptr) {
+        return defaultValue;
+    }
+    if (entry->type != TYPE_STRING) {
+        return entry->intValue != 0;
+    }
+
+    // 이전 형식 ("true"/"1"/"yes")
+    return parseBool(_pool + entry->strOffset, defaultValue);
+}
+
+bool ConfigManager::set(const char* key, const char* value) {
+    bool created;
+    Entry* entry = findOrCreate(key, created);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    // 스키마 숫자 키는 저장 시 1회 변환 (get<K>()에서 파싱하지 않도록)
+    if (entry->schemaId != SCHEMA_NONE) {
+        uint8_t type = pgm_read_byte(&Cfg::SCHEMA[entry->schemaId].type);
+        if (type == Cfg::INT) {
+            return setNumberEntry(entry, created, TYPE_INT, atoi(value));
         }
-        if (strcmp(buf, "false") == 0 ||
-            strcmp(buf, "0") == 0 ||
-            strcmp(buf, "no") == 0 ||
-            strcmp(buf, "NO") == 0) {
-            return false;
+        if (type == Cfg::BOOL) {
+            return setNumberEntry(entry, created, TYPE_BOOL, parseBool(value, false) ? 1 : 0);
         }
     }
-    return defaultValue;
+    return setStringEntry(entry, created, value);
 }
 
-bool ConfigManager::set(const char* key, const char* value) {
-    // 먼저 기존 설정 로드
-    StaticJsonDocument<JSON_DOC_SIZE> doc;
+bool ConfigManager::setStringEntry(Entry* entry, bool created, const char* value) {
+    size_t maxLen = MAX_VALUE_STR_LEN;
+    if (entry->schemaId != SCHEMA_NONE) {
+        maxLen = pgm_read_byte(&Cfg::SCHEMA[entry->schemaId].maxLen);
+    }
 
-    File file = LittleFS.open(LITTLEFS_CONFIG_FILE, "r");
-    if (file) {
-        deserializeJson(doc, file);
-        file.close();
+    size_t len = strlen(value);
+    if (len >= maxLen) {
+        Serial.print(F("[ConfigMgr] Value too long: "));
+        Serial.println(_pool + entry->keyOffset);
+        if (created) {
+            dropLastEntry();
+        }
+        return false;
     }
 
-    // 값 설정
-    doc[key] = value;
+    if (entry->type == TYPE_STRING) {
+        char* current = _pool + entry->strOffset;
+        if (strcmp(current, value) == 0) {
+            return true;  // 변경 없음 - 저장 불필요
+        }
+        if (len <= strlen(current)) {
+            memcpy(current, value, len + 1);  // 제자리 덮어쓰기 (남는 바이트는 압축 때 회수)
+            markDirty(entry->schemaId);
+            return true;
+        }
+    }
 
-    // 원자적 쓰기: 임시 파일에 쓰고 rename
-    File tempFile = LittleFS.open(LITTLEFS_CONFIG_TEMP_FILE, "w");
-    if (!tempFile) {
-        Serial.println(F("[ConfigMgr] Failed to create temp file"));
+    uint16_t offset;
+    if (!poolAdd(value, offset)) {
+        if (created) {
+            dropLastEntry();
+        }
         return false;
     }
 
-    // JSON 직렬화 (Compact)
-    if (serializeJson(doc, tempFile) == 0) {
-        Serial.println(F("[ConfigMgr] Failed to write JSON"));
-        tempFile.close();
+    entry->type = TYPE_STRING;
+    entry->strOffset = offset;
+    markDirty(entry->schemaId);
+    return true;
+}
+
+bool ConfigManager::setNumber(const char* key, ValueType type, int32_t value) {
+    bool created;
+    Entry* entry = findOrCreate(key, created);
+    if (entry == nullptr) {
         return false;
     }
-    tempFile.close();
 
-    // 기존 파일 삭제 후 임시 파일 이름 변경
-    if (LittleFS.exists(LITTLEFS_CONFIG_FILE)) {
-        LittleFS.remove(LITTLEFS_CONFIG_FILE);
+    // 스키마 타입 우선 (문자열 키에 숫자를 넣으면 문자열로 저장)
+    if (entry->schemaId != SCHEMA_NONE) {
+        uint8_t schemaType = pgm_read_byte(&Cfg::SCHEMA[entry->schemaId].type);
+        if (schemaType == Cfg::STRING) {
+            char buf[16];
+            return setStringEntry(entry, created, itoa(value, buf, 10));
+        }
+        type = (ValueType)schemaType;
+    }
+    return setNumberEntry(entry, created, type, value);
+}
+
+bool ConfigManager::setNumberEntry(Entry* entry, bool created, ValueType type, int32_t value) {
+    if (!created && entry->type == type && entry->intValue == value) {
+        return true;  // 변경 없음 - 저장 불필요
+    }
+
+    entry->type = type;
+    entry->intValue = value;
+    markDirty(entry->schemaId);
+    return true;
+}
+
+int32_t ConfigManager::getNumberById(Cfg::Id id) const {
+    uint8_t index = _schemaIndex[id];
+    if (index == SCHEMA_NONE) {
+        return (int32_t)pgm_read_dword(&Cfg::SCHEMA[id].intDefault);
     }
+    return _entries[index].intValue;  // set 시 스키마 타입으로 변환되어 있음
+}
 
-    if (!LittleFS.rename(LITTLEFS_CONFIG_TEMP_FILE, LITTLEFS_CONFIG_FILE)) {
-        Serial.println(F("[ConfigMgr] Failed to rename temp file"));
+bool ConfigManager::getStringById(Cfg::Id id, char* outValue, size_t maxLen) const {
+    uint8_t index = _schemaIndex[id];
+    if (index == SCHEMA_NONE) {
+        strncpy_P(outValue, (const char*)pgm_read_ptr(&Cfg::SCHEMA[id].strDefault), maxLen - 1);
+        outValue[maxLen - 1] = '\0';
         return false;
     }
 
-    _dirty = false;
-    _loaded = true;
+    strncpy(outValue, _pool + _entries[index].strOffset, maxLen - 1);
+    outValue[maxLen - 1] = '\0';
     return true;
 }
 
+bool ConfigManager::setNumberById(Cfg::Id id, int32_t value) {
+    uint8_t index = _schemaIndex[id];
+    if (index == SCHEMA_NONE) {
+        char key[MAX_KEY_LEN];
+        strncpy_P(key, (const char*)pgm_read_ptr(&Cfg::SCHEMA[id].name), sizeof(key) - 1);
+        key[sizeof(key) - 1] = '\0';
+        return setNumber(key, TYPE_INT, value);  // 스키마 타입으로 저장됨
+    }
+
+    Entry* entry = &_entries[index];
+    return setNumberEntry(entry, false, entry->type, value);
+}
+
+bool ConfigManager::setStringById(Cfg::Id id, const char* value) {
+    uint8_t index = _schemaIndex[id];
+    if (index == SCHEMA_NONE) {
+        char key[MAX_KEY_LEN];
+        strncpy_P(key, (const char*)pgm_read_ptr(&Cfg::SCHEMA[id].name), sizeof(key) - 1);
+        key[sizeof(key) - 1] = '\0';
+        return set(key, value);
+    }
+    return setStringEntry(&_entries[index], false, value);
+}
+
 bool ConfigManager::setInt(const char* key, int value) {
-    char buf[16];
-    itoa(value, buf, 10);
-    return set(key, buf);
+    return setNumber(key, TYPE_INT, value);
 }
 
 bool ConfigManager::setBool(const char* key, bool value) {
-    return set(key, value ? "true" : "false");
+    return setNumber(key, TYPE_BOOL, value ? 1 : 0);
 }
 
 bool ConfigManager::save() {
-    // set()에서 이미 자동 저장됨
-    // dirty 상태일 때만 저장하도록 변경 가능
-    return !_dirty;
+    if (!_dirty) {
+        return true;
+    }
+
+    StaticJsonDocument<JSON_DOC_SIZE> doc;
+    if (!buildDocument(doc)) {
+        return false;
+    }
+
+    // 현재 유효 슬롯은 건드리지 않고 다른 슬롯에 다음 세대로 기록
+    uint8_t target = (_activeSlot == 0) ? 1 : 0;
+    File file = LittleFS.open(slotPath(target), "w");
+    if (!file) {
+        Serial.println(F("[ConfigMgr] Failed to open config slot"));
+        return false;
+    }
+
+    // 헤더는 payload 뒤에 기록 - 중간에 전원이 끊기면 magic이 없어 무효 슬롯
+    SlotHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    file.write((const uint8_t*)&hdr, sizeof(hdr));
+
+    SlotWriter writer(file);
+#if LITTLEFS_CONFIG_MSGPACK
+    size_t written = serializeMsgPack(doc, writer);
+    hdr.format = SLOT_FORMAT_MSGPACK;
+#else
+    size_t written = serializeJson(doc, writer);  // Compact
+    hdr.format = SLOT_FORMAT_JSON;
+#endif
+
+    hdr.magic = SLOT_MAGIC;
+    hdr.generation = _generation + 1;
+    hdr.length = (uint16_t)writer.length();
+    hdr.crc = writer.crc();
+
+    bool ok = written > 0 && written == writer.length() && writer.length() <= SLOT_MAX_PAYLOAD &&
+              file.seek(0) && file.write((const uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr);
+    file.close();
+
+    if (!ok) {
+        Serial.println(F("[ConfigMgr] Failed to write config"));
+        return false;
+    }
+
+    _activeSlot = target;
+    _generation = hdr.generation;
+    _dirty = false;
+    Serial.println(F("[ConfigMgr] Config saved"));
+    return true;
+}
+
+bool ConfigManager::importJson(Stream& in) {
+    StaticJsonDocument<JSON_DOC_SIZE> doc;
+    DeserializationError error = deserializeJson(doc, in);
+    if (error) {
+        Serial.print(F("[ConfigMgr] Import parse error: "));
+        Serial.println(error.f_str());
+        return false;
+    }
+    if (!doc.is<JsonObject>()) {
+        Serial.println(F("[ConfigMgr] Import expects a JSON object"));
+        return false;
+    }
+
+    applyDocument(doc);
+    markDirty(SCHEMA_NONE);
+    _pendingChanges = ALL_KEYS;
+    return true;
+}
+
+size_t ConfigManager::exportJson(Print& out) const {
+    StaticJsonDocument<JSON_DOC_SIZE> doc;
+    if (!buildDocument(doc)) {
+        return 0;
+    }
+    return serializeJson(doc, out);
+}
+
+void ConfigManager::update() {
+    if (_inTransaction) {
+        return;
+    }
+
+    // 변경 알림은 저장 지연과 무관하게 바로 (RAM 값은 이미 반영됨)
+    if (_pendingChanges != 0) {
+        publishChanges();
+    }
+
+    if (!_dirty || millis() - _lastChange < SAVE_DELAY_MS) {
+        return;
+    }
+
+    if (!save()) {
+        _lastChange = millis();  // 실패 시 SAVE_DELAY_MS 후 재시도
+    }
+}
+
+bool ConfigManager::beginTransaction() {
+    if (_inTransaction) {
+        Serial.println(F("[ConfigMgr] Transaction already open"));
+        return false;
+    }
+
+    // @MX:NOTE: [롤백 기준점] 별도 스냅샷 버퍼 대신 설정 파일을 사용 (RAM 절약)
+    // 대기 중인 변경을 먼저 기록해야 rollback()이 트랜잭션 이전 상태로 돌아감
+    if (!save()) {
+        return false;
+    }
+
+    // 저장과 달리 알림은 아직 발행 전일 수 있음 - rollback()이 파일을 다시 읽어도 유지
+    _txPendingChanges = _pendingChanges;
+    _inTransaction = true;
+    return true;
+}
+
+bool ConfigManager::commit() {
+    if (!_inTransaction) {
+        return false;
+    }
+
+    _inTransaction = false;
+    bool saved = save();
+
+    // @MX:NOTE: [알림 먼저] 저장 실패해도 RAM 값은 확정되므로 알림은 발행함
+    // (트랜잭션 밖의 set*()도 update()에서 저장 전에 발행 - 저장은 update()가 재시도)
+    publishChanges();
+    return saved;
+}
+
+bool ConfigManager::rollback() {
+    if (!_inTransaction) {
+        return false;
+    }
+
+    _inTransaction = false;
+    if (!_dirty) {
+        return true;  // 변경 없음 - 다시 읽을 필요 없음
+    }
+
+    if (!load()) {
+        // 파일 없음 = 트랜잭션 시작 시 빈 설정
+        clearEntries();
+        _dirty = false;
+    }
+    _pendingChanges = _txPendingChanges;  // 취소된 변경은 알리지 않고 이전 변경만 유지
+    Serial.println(F("[ConfigMgr] Transaction rolled back"));
+    return true;
 }
 
 bool ConfigManager::reload() {
     _loaded = false;
-    return load();
+    if (!load()) {
+        return false;
+    }
+    _pendingChanges = ALL_KEYS;
+    return true;
 }
 
 bool ConfigManager::reset() {
-    // 설정 파일 삭제
-    if (LittleFS.exists(LITTLEFS_CONFIG_FILE)) {
-        LittleFS.remove(LITTLEFS_CONFIG_FILE);
+    // 설정 파일 삭제 (슬롯 + 이전 형식)
+    const char* paths[] = {
+        LITTLEFS_CONFIG_SLOT_A_FILE,
+        LITTLEFS_CONFIG_SLOT_B_FILE,
+        LITTLEFS_CONFIG_BIN_FILE,
+        LITTLEFS_CONFIG_FILE
+    };
+    for (size_t i = 0; i < 4; i++) {
+        if (LittleFS.exists(paths[i])) {
+            LittleFS.remove(paths[i]);
+        }
     }
-    _loaded = false;
-    _dirty = true;
+    _activeSlot = SLOT_NONE;
+    _generation = 0;
+    clearEntries();
+    _dirty = false;  // 저장할 내용 없음 (파일이 이미 기본 상태)
+    _pendingChanges = ALL_KEYS;
     return true;
 }
 
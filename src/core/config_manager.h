@@ -3,18 +3,33 @@
 
 #include <Arduino.h>
 #include <FS.h>
+#include <type_traits>
 #include "arthur_littlefs.h"
+#include "config_schema.h"
+
+struct Event;
 
 /**
  * @brief ConfigManager
  *
- * LittleFS 기반 JSON 설정 관리자
+ * LittleFS 기반 설정 관리자
  * - ArduinoJson 7.0.0 사용
- * - 원자적 쓰기 (temp 파일 + rename)
+ * - 플래시에는 MessagePack으로 저장 (LITTLEFS_CONFIG_MSGPACK=0이면 JSON)
+ * - A/B 슬롯 + 세대 번호 + CRC32 (저장 중 전원 차단 시 이전 세대로 부팅)
+ * - JSON은 가져오기/내보내기 (캡티브 포털, 시리얼 콘솔)와 이전 파일 마이그레이션에만 사용
+ * - begin()에서 한 번만 파싱해 RAM 테이블에 보관 (조회 시 파일 I/O 없음)
+ * - set*()은 RAM만 변경하고 dirty 표시, save() 또는 update()의 지연 저장으로 기록
  * - 정적 할당만 사용 (new/malloc 금지)
  * - String 클래스 미사용 (char[] + F() 매크로)
  *
  * @MX:NOTE: [자동 마운트] 첫 begin() 호출 시 LittleFS 자동 마운트
+ * @MX:NOTE: [스키마 키] config_schema.h에 선언된 키는 get<K>()/set<K>()로 ID 기반 접근
+ *           (이름 기반 get()/set()도 같은 항목을 읽고 씀)
+ * @MX:NOTE: [변경 알림] 스키마 키 값이 바뀌면 update()에서 키별 CONFIG_CHANGED 발행
+ *           (트랜잭션 중 변경은 commit() 때 발행, rollback()은 트랜잭션 이전 변경만 발행)
+ *           알림은 플래시 저장보다 먼저일 수 있음 (저장 실패 시에도 RAM 값 기준으로 발행)
+ * @MX:NOTE: [지연 저장] 마지막 변경 후 SAVE_DELAY_MS 동안 변경이 없으면 update()가 저장
+ *           (연속된 set*()이 플래시 쓰기 1회로 합쳐짐, 전원 차단 시 그 사이 변경은 유실)
  * @MX:ANCHOR: [설정 저장 인터페이스] 모듈 전체에서 설정 저장/로드에 사용
  * @MX:REASON: fan_in >= 3 (WeatherModule, TimeManager, SensorModule 등)
  */
@@ -27,6 +42,13 @@ public:
     static const size_t MAX_KEY_LEN = 32;
     static const size_t MAX_VALUE_STR_LEN = 64;
 
+    // RAM 설정 테이블 크기 (키/문자열 값은 공유 문자열 풀에 저장)
+    static const size_t MAX_ENTRIES = 24;
+    static const size_t STRING_POOL_SIZE = 768;
+
+    // 마지막 변경 후 자동 저장까지 대기 시간
+    static const unsigned long SAVE_DELAY_MS = 5000;
+
     /**
      * @brief 생성자
      */
@@ -71,13 +93,58 @@ public:
      */
     bool getBool(const char* key, bool defaultValue);
 
+    /**
+     * @brief 스키마 키 값 가져오기 (INT/BOOL)
+     *
+     * 예: bool on = ConfigMgr.get<Cfg::SomeFlag>();
+     *
+     * @return 저장된 값, 없으면 스키마 기본값
+     */
+    template <typename K>
+    typename std::enable_if<K::type != Cfg::STRING, typename K::Value>::type get() const {
+        return static_cast<typename K::Value>(getNumberById(K::id));
+    }
+
+    /**
+     * @brief 스키마 키 값 가져오기 (STRING)
+     *
+     * 문자열 풀은 압축 시 이동하므로 포인터 대신 복사본 반환
+     *
+     * @param outValue 출력 버퍼
+     * @param maxLen 버퍼 크기
+     * @return true 값 찾음
+     * @return false 값 없음 (스키마 기본값 복사)
+     */
+    template <typename K>
+    typename std::enable_if<K::type == Cfg::STRING, bool>::type get(char* outValue, size_t maxLen) const {
+        return getStringById(K::id, outValue, maxLen);
+    }
+
+    /**
+     * @brief 스키마 키 값 설정 (INT/BOOL)
+     */
+    template <typename K>
+    typename std::enable_if<K::type != Cfg::STRING, bool>::type set(typename K::Value value) {
+        return setNumberById(K::id, static_cast<int32_t>(value));
+    }
+
+    /**
+     * @brief 스키마 키 값 설정 (STRING, 스키마 maxLen 초과 시 실패)
+     */
+    template <typename K>
+    typename std::enable_if<K::type == Cfg::STRING, bool>::type set(const char* value) {
+        return setStringById(K::id, value);
+    }
+
     /**
      * @brief 문자열 값 설정
      *
+     * RAM 테이블만 변경 (값이 바뀐 경우에만 dirty 표시)
+     *
      * @param key 설정 키
      * @param value 설정 값
      * @return true 설정 성공
-     * @return false 설정 실패
+     * @return false 설정 실패 (키/값 길이 초과 또는 테이블/문자열 풀 가득 참)
      */
     bool set(const char* key, const char* value);
 
@@ -104,11 +171,66 @@ public:
     /**
      * @brief 설정을 파일에 저장 (원자적 쓰기)
      *
-     * @return true 저장 성공
-     * @return false 저장 실패
+     * dirty 상태일 때만 기록, 현재 슬롯이 아닌 슬롯에 다음 세대로 기록
+     *
+     * @return true 저장 성공 또는 변경 없음
+     * @return false 저장 실패 (dirty 유지)
      */
     bool save();
 
+    /**
+     * @brief 주기적 업데이트 (loop에서 호출)
+     *
+     * 마지막 변경 후 SAVE_DELAY_MS가 지났으면 save() (트랜잭션 중에는 보류)
+     */
+    void update();
+
+    /**
+     * @brief 트랜잭션 시작 (여러 set*()을 한 번의 원자적 쓰기로 묶음)
+     *
+     * 대기 중인 변경이 있으면 먼저 저장해 파일을 롤백 기준점으로 만듦
+     *
+     * @return true 시작됨
+     * @return false 이미 트랜잭션 중이거나 대기 중인 변경 저장 실패
+     */
+    bool beginTransaction();
+
+    /**
+     * @brief 트랜잭션 확정 (변경이 있을 때만 파일 1회 기록)
+     *
+     * 변경 알림(CONFIG_CHANGED)은 저장 성공 여부와 관계없이 발행됨 - 알림은 RAM 값 기준이며
+     * 플래시 기록은 update()의 지연 저장과 같이 나중에 따라잡음
+     *
+     * @return true 저장 성공 또는 변경 없음
+     * @return false 트랜잭션 중이 아니거나 저장 실패 (변경은 RAM에 남고 update()가 재시도)
+     */
+    bool commit();
+
+    /**
+     * @brief 트랜잭션 취소 (파일에서 트랜잭션 시작 시점 상태 복원)
+     *
+     * 트랜잭션 이전에 발행 대기 중이던 변경 알림은 유지됨
+     *
+     * @return true 복원 성공
+     * @return false 트랜잭션 중이 아님
+     */
+    bool rollback();
+
+    /**
+     * @brief 트랜잭션 진행 중 여부
+     */
+    bool inTransaction() const { return _inTransaction; }
+
+    /**
+     * @brief CONFIG_CHANGED 이벤트의 변경된 키
+     *
+     * 예: if (ConfigManager::changedKey(event) == Cfg::WEATHER_LOCATION) { ... }
+     *
+     * @param event CONFIG_CHANGED 이벤트
+     * @return Cfg::Id 변경된 키 (payload가 없으면 Cfg::KEY_COUNT)
+     */
+    static Cfg::Id changedKey(const Event& event);
+
     /**
      * @brief 설정이 변경되었는지 확인
      *
@@ -117,9 +239,30 @@ public:
      */
     bool isDirty() const { return _dirty; }
 
+    /**
+     * @brief JSON 설정 가져오기 (기존 설정 전체 교체)
+     *
+     * 저장은 set*()과 같이 save() 또는 update()의 지연 저장으로 기록
+     *
+     * @param in JSON 객체 입력 (웹 요청 본문, Serial 등)
+     * @return true 가져오기 성공
+     * @return false 파싱 실패 (기존 설정 유지)
+     */
+    bool importJson(Stream& in);
+
+    /**
+     * @brief 현재 설정을 JSON으로 내보내기
+     *
+     * @param out 출력 (웹 응답, Serial 등)
+     * @return size_t 기록한 바이트 수 (실패 시 0)
+     */
+    size_t exportJson(Print& out) const;
+
     /**
      * @brief 설정 파일 다시 로드
      *
+     * 저장하지 않은 변경은 버려짐
+     *
      * @return true 로드 성공
      * @return false 로드 실패
      */
@@ -141,9 +284,103 @@ public:
     size_t getFreeHeap() const;
 
 private:
+    // 값 타입 (파일의 JSON 타입을 유지)
+    enum ValueType : uint8_t {
+        TYPE_STRING = Cfg::STRING,
+        TYPE_INT = Cfg::INT,
+        TYPE_BOOL = Cfg::BOOL
+    };
+
+    static const uint8_t SCHEMA_NONE = 0xFF;
+    static const uint8_t SLOT_NONE = 0xFF;
+
+    // 설정 슬롯 헤더 (16바이트) - payload 기록 후 마지막에 기록
+    static const uint32_t SLOT_MAGIC = 0x31464341;  // "ACF1"
+    static const uint8_t SLOT_FORMAT_JSON = 0;
+    static const uint8_t SLOT_FORMAT_MSGPACK = 1;
+    static const uint16_t SLOT_MAX_PAYLOAD = 4096;
+    struct SlotHeader {
+        uint32_t magic;
+        uint32_t generation;  // 저장할 때마다 +1, 높은 쪽이 최신
+        uint16_t length;      // payload 바이트
+        uint8_t format;       // SLOT_FORMAT_* (빌드 설정과 무관하게 읽기 가능)
+        uint8_t reserved;
+        uint32_t crc;         // payload CRC32
+    };
+    static const uint32_t ALL_KEYS = (Cfg::KEY_COUNT >= 32) ? 0xFFFFFFFFUL : ((1UL << Cfg::KEY_COUNT) - 1);
+
+    // 설정 항목 1개 (16바이트) - 키와 문자열 값은 _pool 오프셋
+    struct Entry {
+        uint32_t hash;        // 키 해시 (FNV-1a)
+        int32_t intValue;     // TYPE_INT/TYPE_BOOL 값
+        uint16_t keyOffset;
+        uint16_t strOffset;   // TYPE_STRING 값
+        ValueType type;
+        uint8_t schemaId;     // Cfg::Id (스키마에 없는 키는 SCHEMA_NONE)
+    };
+
     bool _mounted;
     bool _dirty;
     bool _loaded;
+    bool _inTransaction;
+    unsigned long _lastChange;  // 마지막 set*() 시각 (지연 저장 기준)
+    uint32_t _pendingChanges;   // 알림 대기 중인 스키마 키 (비트 = Cfg::Id)
+    uint32_t _txPendingChanges; // beginTransaction() 시점의 _pendingChanges (rollback()이 복원)
+    uint8_t _activeSlot;        // 마지막으로 읽거나 쓴 유효 슬롯 (0=A, 1=B)
+    uint32_t _generation;       // _activeSlot의 세대
+
+    Entry _entries[MAX_ENTRIES];
+    uint8_t _entryCount;
+    uint8_t _schemaIndex[Cfg::KEY_COUNT];  // Cfg::Id -> _entries 인덱스 (SCHEMA_NONE이면 미설정)
+    char _pool[STRING_POOL_SIZE];
+    size_t _poolUsed;
+
+    static uint32_t hashKey(const char* key);
+
+    // 키 검색 (없으면 nullptr)
+    const Entry* findEntry(const char* key) const;
+
+    // 키 검색, 없으면 새 항목 생성 (실패 시 nullptr)
+    Entry* findOrCreate(const char* key, bool& outCreated);
+
+    // 방금 생성한 마지막 항목 취소
+    void dropLastEntry();
+
+    // 정수/불리언 값 변경 (공통)
+    bool setNumber(const char* key, ValueType type, int32_t value);
+
+    // 항목 값 변경 (created면 실패 시 항목 취소)
+    bool setStringEntry(Entry* entry, bool created, const char* value);
+    bool setNumberEntry(Entry* entry, bool created, ValueType type, int32_t value);
+
+    // 스키마 키 접근 (ID -> 항목 인덱스, 없으면 PROGMEM 기본값)
+    int32_t getNumberById(Cfg::Id id) const;
+    bool getStringById(Cfg::Id id, char* outValue, size_t maxLen) const;
+    bool setNumberById(Cfg::Id id, int32_t value);
+    bool setStringById(Cfg::Id id, const char* value);
+
+    // 문자열 풀에 추가 (실패 시 false, 필요하면 풀 압축)
+    bool poolAdd(const char* str, uint16_t& outOffset);
+
+    // 더 이상 참조되지 않는 문자열 제거
+    void poolCompact();
+
+    // 값 변경 기록 (스키마 키면 알림 대기 목록에 추가)
+    void markDirty(uint8_t schemaId);
+
+    // 대기 중인 변경을 CONFIG_CHANGED로 발행
+    void publishChanges();
+
+    // 파싱된 문서 -> RAM 테이블 (ArduinoJson 타입을 헤더에 노출하지 않도록 템플릿)
+    template <typename TDocument>
+    void applyDocument(TDocument& doc);
+
+    // RAM 테이블 -> 직렬화용 문서
+    template <typename TDocument>
+    bool buildDocument(TDocument& doc) const;
+
+    // RAM 테이블 비우기
+    void clearEntries();
 
     // LittleFS 마운트 (내부 사용)
     bool mount();
@@ -151,6 +388,17 @@ private:
     // 설정 파일 로드 (내부 사용)
     bool load();
 
+    // 슬롯 헤더 읽기 (magic/길이 확인)
+    bool readSlotHeader(uint8_t slot, SlotHeader& hdr);
+
+    // 슬롯 payload 파싱 + CRC 확인
+    template <typename TDocument>
+    bool readSlot(uint8_t slot, const SlotHeader& hdr, TDocument& doc);
+
+    // 이전 단일 파일 형식 가져오기 (슬롯이 없을 때)
+    template <typename TDocument>
+    bool migrateLegacy(TDocument& doc);
+
     // 디렉토리 생성 (내부 사용)
     bool ensureDirectories();
 };
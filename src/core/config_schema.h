@@ -0,0 +1,70 @@
+#ifndef ARTHUR_CONFIG_SCHEMA_H
+#define ARTHUR_CONFIG_SCHEMA_H
+
+#include <Arduino.h>
+
+/**
+ * @brief 설정 스키마 (컴파일 타임)
+ *
+ * 알려진 설정 키의 ID, 타입, 기본값, 최대 길이를 선언
+ * ConfigMgr.get<Cfg::WeatherLocation>(buf, len)처럼 키 타입으로 접근하면
+ * 문자열 비교/숫자 파싱 없이 ID로 바로 조회됨
+ *
+ * @MX:NOTE: [키 추가] Id에 항목 추가 -> 이름/기본값 PROGMEM 문자열 -> SCHEMA 행 -> 키 타입 선언
+ * @MX:WARN: [파일 호환] name은 설정 파일의 JSON/MessagePack 키 - 바꾸면 기존 값을 읽지 못함
+ */
+namespace Cfg {
+
+// 값 타입 (ConfigManager 내부 저장 타입과 동일)
+enum Type : uint8_t {
+    STRING,
+    INT,
+    BOOL
+};
+
+// 키 ID (SCHEMA 인덱스)
+enum Id : uint8_t {
+    WEATHER_API_KEY,
+    WEATHER_LOCATION,
+    WEATHER_INTERVAL,
+    KEY_COUNT
+};
+
+// 스키마 행 (PROGMEM, pgm_read_*로 읽음)
+struct KeyInfo {
+    const char* name;        // 파일 키 (PROGMEM)
+    const char* strDefault;  // STRING 기본값 (PROGMEM)
+    int32_t intDefault;      // INT/BOOL 기본값
+    Type type;
+    uint8_t maxLen;          // STRING 최대 길이 (널 포함)
+};
+
+static const char NAME_WEATHER_API_KEY[] PROGMEM = "weather_api_key";
+static const char NAME_WEATHER_LOCATION[] PROGMEM = "weather_location";
+static const char NAME_WEATHER_INTERVAL[] PROGMEM = "weather_interval";
+static const char DEFAULT_EMPTY[] PROGMEM = "";
+static const char DEFAULT_WEATHER_LOCATION[] PROGMEM = "Seoul,KR";
+
+constexpr KeyInfo SCHEMA[KEY_COUNT] PROGMEM = {
+    { NAME_WEATHER_API_KEY,  DEFAULT_EMPTY,                 0, STRING, 64 },
+    { NAME_WEATHER_LOCATION, DEFAULT_WEATHER_LOCATION,      0, STRING, 32 },
+    { NAME_WEATHER_INTERVAL, DEFAULT_EMPTY,            600000, INT,     0 },  // 날씨 갱신 주기 (ms)
+};
+
+// 키 타입 기반 (Value: get/set 값 타입)
+template <Id KeyId, Type KeyType, typename TValue>
+struct Key {
+    static constexpr Id id = KeyId;
+    static constexpr Type type = KeyType;
+    typedef TValue Value;
+
+    static_assert(SCHEMA[KeyId].type == KeyType, "Cfg key type does not match SCHEMA");
+};
+
+struct WeatherApiKey : Key<WEATHER_API_KEY, STRING, const char*> {};
+struct WeatherLocation : Key<WEATHER_LOCATION, STRING, const char*> {};
+struct WeatherInterval : Key<WEATHER_INTERVAL, INT, uint32_t> {};
+
+}  // namespace Cfg
+
+#endif // ARTHUR_CONFIG_SCHEMA_H
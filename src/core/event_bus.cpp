@@ -5,11 +5,36 @@
 // 전역 인스턴스 정의
 EventBus gEventBus;
 
+// 타입별 기본 큐 정책 (EventType 순서)
+// @MX:NOTE: [정책] 상태형 이벤트는 최신 값 하나면 충분 -> COALESCE, 연결 상태 전환은 유실 금지 -> NEVER_DROP
+// CONFIG_CHANGED는 키마다 payload가 달라 합치면 안 됨 (실패 시 ConfigManager가 다음 update()에서 재발행)
+static const EventPolicy DEFAULT_POLICIES[EVENT_TYPE_COUNT] PROGMEM = {
+    POLICY_NEVER_DROP,   // WIFI_CONNECTED
+    POLICY_NEVER_DROP,   // WIFI_DISCONNECTED
+    POLICY_COALESCE,     // TIME_SYNCED
+    POLICY_COALESCE,     // SENSOR_UPDATED
+    POLICY_COALESCE,     // WEATHER_UPDATED
+    POLICY_DROP_NEWEST,  // CONFIG_CHANGED
+    POLICY_DROP_NEWEST,  // BUTTON_PRESSED (ISR 링이 버스트를 흡수)
+};
+
 EventBus::EventBus()
     : _queueHead(0)
     , _queueTail(0)
     , _queueCount(0)
+    , _reservedFree(0)
+    , _retainedValid(0)
+    , _dropCount(0)
+    , _coalesceCount(0)
+    , _isrHead(0)
+    , _isrTail(0)
+    , _isrDropCount(0)
     , _initialized(false)
+    , _updating(false)
+    , _dispatching(false)
+    , _batchRemaining(0)
+    , _timerNow(0)
+    , _timerLastMs(0)
 {
     // 구독자 배열 초기화
     for (int type = 0; type < MAX_EVENT_TYPES; type++) {
@@ -18,19 +43,29 @@ EventBus::EventBus()
             _subscribers[type][i].userData = nullptr;
         }
     }
+
+    for (int type = 0; type < EVENT_TYPE_COUNT; type++) {
+        _policies[type] = (EventPolicy)pgm_read_byte(&DEFAULT_POLICIES[type]);
+        _retainedPending[type] = 0;
+    }
+    resetQueue();
+    resetTimers();
+#if EVENT_BUS_PROFILE
+    resetStats();
+#endif
 }
 
 void EventBus::begin() {
-    _queueHead = 0;
-    _queueTail = 0;
-    _queueCount = 0;
+    resetQueue();
+    _timerLastMs = millis();
 
     _initialized = true;
 
     Serial.println(F("EventBus initialized"));
 }
 
-bool EventBus::subscribe(EventType type, EventCallback callback, void* userData) {
+bool EventBus::subscribe(EventType type, EventCallback callback, void* userData,
+                         bool deliverRetained) {
     // 타입 유효성 검사
     if (type < 0 || type >= EVENT_TYPE_COUNT) {
         return false;
@@ -46,6 +81,11 @@ bool EventBus::subscribe(EventType type, EventCallback callback, void* userData)
         if (_subscribers[type][i].callback == nullptr) {
             _subscribers[type][i].callback = callback;
             _subscribers[type][i].userData = userData;
+
+            // 보관된 이벤트가 있으면 다음 update()에서 이 구독자에게만 전달
+            if (deliverRetained && (_retainedValid & (1 << type))) {
+                _retainedPending[type] |= (uint8_t)(1 << i);
+            }
             return true;
         }
     }
@@ -57,47 +97,265 @@ bool EventBus::subscribe(EventType type, EventCallback callback, void* userData)
 }
 
 bool EventBus::publish(const Event& event) {
+    return publishPayload(event.type, event.payload, event.size);
+}
+
+bool EventBus::publish(EventType type) {
+    return publishPayload(type, nullptr, 0);
+}
+
+bool EventBus::publishPayload(EventType type, const void* payload, size_t size) {
     // 타입 유효성 검사
-    if (event.type < 0 || event.type >= EVENT_TYPE_COUNT) {
+    if (type < 0 || type >= EVENT_TYPE_COUNT) {
         return false;
     }
 
-    // 큐가 가득 찼는지 확인
-    if (_queueCount >= EVENT_QUEUE_SIZE) {
-        Serial.println(F("EventBus: Event queue full"));
-        return false;
+    EventPolicy policy = _policies[type];
+#if EVENT_BUS_PROFILE
+    _typePublished[type]++;
+#endif
+
+    // 같은 타입이 대기 중이면 그 슬롯을 최신 값으로 교체 (큐 위치는 유지)
+    if (policy == POLICY_COALESCE && _pendingCount[type] > 0) {
+        int offset = findPending(type, true);
+        if (offset >= 0) {
+            writeSlot(_eventQueue[(_queueHead + offset) % EVENT_QUEUE_SIZE], type, payload, size);
+            _coalesceCount++;
+#if EVENT_BUS_PROFILE
+            _typeCoalesced[type]++;
+#endif
+            return true;
+        }
+        // 전파 중인 head 슬롯뿐이면 새로 추가
     }
 
-    // 큐에 이벤트 추가
-    _eventQueue[_queueTail] = event;
-    _eventQueue[_queueTail].timestamp = millis();
+    // 큐가 가득 찼는지 확인 (예약 슬롯 제외)
+    if (!hasRoom(type)) {
+        int victim = -1;
+        if (policy == POLICY_DROP_OLDEST) {
+            victim = findPending(type, true);
+        } else if (policy == POLICY_NEVER_DROP) {
+            victim = findPending(type, false);
+        }
 
+        _dropCount++;
+        if (victim < 0) {
+#if EVENT_BUS_PROFILE
+            _typeDropped[type]++;
+#endif
+            Serial.println(F("EventBus: Event queue full"));
+            return false;
+        }
+        removeAt(victim);
+    }
+
+    // 큐 슬롯에 직접 기록 (중간 Event 복사 없음)
+    writeSlot(_eventQueue[_queueTail], type, payload, size);
+#if EVENT_BUS_PROFILE
+    _enqueueMicros[_queueTail] = micros();
+#endif
     _queueTail = (_queueTail + 1) % EVENT_QUEUE_SIZE;
     _queueCount++;
+    trackPush(type);
 
+#if EVENT_BUS_PROFILE
+    if (_queueCount > _queueHighWater) {
+        _queueHighWater = (uint8_t)_queueCount;
+    }
+    if (_pendingCount[type] > _pendingHighWater[type]) {
+        _pendingHighWater[type] = _pendingCount[type];
+    }
+#endif
     return true;
 }
 
-int EventBus::update() {
-    if (!_initialized) {
+bool EventBus::setPolicy(EventType type, EventPolicy policy) {
+    if (type < 0 || type >= EVENT_TYPE_COUNT) {
+        return false;
+    }
+
+    // 예약 슬롯 수 갱신
+    bool wasReserved = (_policies[type] == POLICY_NEVER_DROP);
+    bool isReserved = (policy == POLICY_NEVER_DROP);
+    if (wasReserved != isReserved && _pendingCount[type] == 0) {
+        _reservedFree += isReserved ? 1 : -1;
+    }
+
+    _policies[type] = policy;
+    return true;
+}
+
+const Event* EventBus::retained(EventType type) const {
+    if (type < 0 || type >= EVENT_TYPE_COUNT) {
+        return nullptr;
+    }
+    return (_retainedValid & (1 << type)) ? &_retained[type] : nullptr;
+}
+
+bool IRAM_ATTR EventBus::publishFromISR(EventType type, uint32_t value) {
+    // @MX:WARN: [IRAM] 플래시 코드/Serial 호출 금지 - 여기서 부르는 것은 모두 인라인 연산
+    if (type < 0 || type >= EVENT_TYPE_COUNT) {
+        return false;
+    }
+
+    uint8_t head = _isrHead;
+    uint8_t next = (head + 1) & (ISR_QUEUE_SIZE - 1);
+    if (next == _isrTail) {
+        _isrDropCount = _isrDropCount + 1;
+        return false;
+    }
+
+    _isrQueue[head].type = (uint8_t)type;
+    _isrQueue[head].value = value;
+
+    // 슬롯 기록이 인덱스 공개보다 먼저 (단일 코어라 컴파일러 재배치만 막으면 됨)
+    std::atomic_signal_fence(std::memory_order_release);
+    _isrHead = next;
+    return true;
+}
+
+bool EventBus::requestRetained(EventType type, EventCallback callback) {
+    if (retained(type) == nullptr) {
+        return false;
+    }
+
+    for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
+        if (_subscribers[type][i].callback == callback) {
+            _retainedPending[type] |= (uint8_t)(1 << i);
+            return true;
+        }
+    }
+    return false;
+}
+
+EventPolicy EventBus::getPolicy(EventType type) const {
+    if (type < 0 || type >= EVENT_TYPE_COUNT) {
+        return POLICY_DROP_NEWEST;
+    }
+    return _policies[type];
+}
+
+int EventBus::update(int maxEvents, uint32_t maxMicros) {
+    if (!_initialized || _updating) {
         return 0;
     }
+    _updating = true;
+
+    uint32_t start = micros();
+
+    // 만료된 타이머 이벤트를 큐로
+    advanceTimers();
+
+    // 인터럽트에서 발행된 이벤트를 일반 큐로 (정책/retained 동일 적용)
+    drainIsrQueue();
 
-    int processed = 0;
+    // 늦게 구독한 모듈에 현재 상태부터 전달 (큐의 새 이벤트보다 먼저)
+    int processed = deliverRetained();
+
+    // 시작 시점의 이벤트만 처리 (콜백이 발행한 이벤트는 다음 호출로)
+    // @MX:NOTE: [예산] 합치기는 개수를 바꾸지 않고, 앞쪽 이벤트 제거는 removeAt()이 _batchRemaining을 줄임
+    _batchRemaining = _queueCount;
+    int dispatched = 0;
+
+    while (_batchRemaining > 0) {
+        if (maxEvents > 0 && dispatched >= maxEvents) {
+            break;
+        }
+        if (maxMicros > 0 && dispatched > 0 && (uint32_t)(micros() - start) >= maxMicros) {
+            break;
+        }
+
+        // 슬롯에서 바로 전파 (콜백이 끝날 때까지 슬롯을 비우지 않으므로 재발행에 덮이지 않음)
+        Event& event = _eventQueue[_queueHead];
+#if EVENT_BUS_PROFILE
+        uint32_t residenceUs = micros() - _enqueueMicros[_queueHead];
+        _typeDispatched[event.type]++;
+        _residenceTotalUs[event.type] += residenceUs;
+        if (residenceUs > _residenceMaxUs[event.type]) {
+            _residenceMaxUs[event.type] = residenceUs;
+        }
+#endif
+        _dispatching = true;
+        dispatchEvent(event);
+        if (!_dispatching) {
+            break;  // 콜백에서 clear()로 큐가 비워짐
+        }
+        _dispatching = false;
+
+        // 전파가 끝난 뒤 보관 (이후 재전달은 isRetained()로 구분됨)
+        EventType type = event.type;
+        _retained[type] = event;
+        _retained[type].flags |= EVENT_FLAG_RETAINED;
+        _retainedValid |= (uint8_t)(1 << type);
 
-    // 큐에 있는 모든 이벤트 처리
-    while (_queueCount > 0) {
-        // 이벤트 꺼내기
-        Event event = _eventQueue[_queueHead];
         _queueHead = (_queueHead + 1) % EVENT_QUEUE_SIZE;
         _queueCount--;
+        trackPop(type);
+        _batchRemaining--;
+        dispatched++;
+    }
 
-        // 등록된 구독자들에게 전파
-        dispatchEvent(event);
-        processed++;
+    _batchRemaining = 0;
+    _updating = false;
+    return processed + dispatched;
+}
+
+int EventBus::queuedCount() const {
+    return _queueCount + ((_isrHead - _isrTail) & (ISR_QUEUE_SIZE - 1));
+}
+
+int EventBus::publishAfter(const Event& event, uint32_t delayMs) {
+    return addTimer(event.type, event.payload, event.size, delayMs, false);
+}
+
+int EventBus::publishAfter(EventType type, uint32_t delayMs) {
+    return addTimer(type, nullptr, 0, delayMs, false);
+}
+
+int EventBus::publishEvery(const Event& event, uint32_t periodMs) {
+    return addTimer(event.type, event.payload, event.size, periodMs, true);
+}
+
+int EventBus::publishEvery(EventType type, uint32_t periodMs) {
+    return addTimer(type, nullptr, 0, periodMs, true);
+}
+
+bool EventBus::cancelTimer(int timerId) {
+    if (timerId < 0 || timerId >= EVENT_TIMER_COUNT || !_timers[timerId].active) {
+        return false;
+    }
+    unlinkTimer((uint8_t)timerId);
+    _timers[timerId].active = false;
+    return true;
+}
+
+uint32_t EventBus::nextTimerDelay() const {
+    uint32_t nearest = UINT32_MAX;
+    for (int i = 0; i < EVENT_TIMER_COUNT; i++) {
+        if (!_timers[i].active) {
+            continue;
+        }
+        int32_t ticks = (int32_t)(_timers[i].expire - _timerNow);
+        if (ticks <= 0) {
+            return 0;
+        }
+        if ((uint32_t)ticks < nearest) {
+            nearest = (uint32_t)ticks;
+        }
+    }
+    if (nearest == UINT32_MAX) {
+        return UINT32_MAX;
     }
 
-    return processed;
+    // 아직 틱으로 반영되지 않은 경과 시간 차감 (틱 -> 밀리초는 32비트를 넘을 수 있음)
+    uint32_t pendingMs = millis() - _timerLastMs;
+    uint64_t delayMs = (uint64_t)nearest * EVENT_TIMER_TICK_MS;
+    if (pendingMs >= delayMs) {
+        return 0;
+    }
+    delayMs -= pendingMs;
+    // UINT32_MAX는 "타이머 없음"으로 예약
+    return (delayMs < UINT32_MAX) ? (uint32_t)delayMs : UINT32_MAX - 1;
 }
 
 void EventBus::unsubscribe(EventType type, EventCallback callback) {
@@ -111,6 +369,7 @@ void EventBus::unsubscribe(EventType type, EventCallback callback) {
         if (_subscribers[type][i].callback == callback) {
             _subscribers[type][i].callback = nullptr;
             _subscribers[type][i].userData = nullptr;
+            _retainedPending[type] &= (uint8_t)~(1 << i);
             return;
         }
     }
@@ -124,20 +383,391 @@ void EventBus::clear() {
         }
     }
 
-    // 큐 초기화
-    _queueHead = 0;
-    _queueTail = 0;
-    _queueCount = 0;
+    // 큐, 타이머, 보관 이벤트 초기화 (ISR 링은 소비자 쪽 인덱스만 옮겨 비움)
+    resetQueue();
+    resetTimers();
+    _isrTail = _isrHead;
+    _retainedValid = 0;
+    for (int type = 0; type < EVENT_TYPE_COUNT; type++) {
+        _retainedPending[type] = 0;
+    }
 }
 
 void EventBus::dispatchEvent(const Event& event) {
     // 이 이벤트 타입을 구독한 모든 콜백 호출
     for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
-        Subscriber& sub = _subscribers[event.type][i];
+        if (_subscribers[event.type][i].callback != nullptr) {
+            invokeSubscriber(event.type, (uint8_t)i, event);
+        }
+    }
+}
+
+void EventBus::drainIsrQueue() {
+    uint8_t head = _isrHead;
+    std::atomic_signal_fence(std::memory_order_acquire);
 
-        if (sub.callback != nullptr) {
-            // 콜백 호출
-            sub.callback(event, sub.userData);
+    uint8_t tail = _isrTail;
+    while (tail != head) {
+        const IsrEvent& slot = _isrQueue[tail];
+        uint32_t value = slot.value;
+        publishPayload((EventType)slot.type, &value, sizeof(value));
+
+        // 슬롯을 다 읽은 뒤 반환
+        std::atomic_signal_fence(std::memory_order_release);
+        tail = (tail + 1) & (ISR_QUEUE_SIZE - 1);
+        _isrTail = tail;
+    }
+}
+
+int EventBus::deliverRetained() {
+    int delivered = 0;
+
+    for (int type = 0; type < EVENT_TYPE_COUNT; type++) {
+        uint8_t pending = _retainedPending[type];
+        if (pending == 0) {
+            continue;
+        }
+        // 콜백 안에서 다시 구독할 수 있으므로 먼저 비움
+        _retainedPending[type] = 0;
+
+        for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
+            if ((pending & (1 << i)) && _subscribers[type][i].callback != nullptr) {
+                invokeSubscriber((EventType)type, (uint8_t)i, _retained[type]);
+            }
+        }
+        delivered++;
+    }
+
+    return delivered;
+}
+
+bool EventBus::hasRoom(EventType type) const {
+    int freeSlots = EVENT_QUEUE_SIZE - _queueCount;
+
+    // 대기 이벤트가 없는 NEVER_DROP 타입은 자기 예약 슬롯 사용
+    if (_policies[type] == POLICY_NEVER_DROP && _pendingCount[type] == 0) {
+        return freeSlots > 0;
+    }
+    return freeSlots > _reservedFree;
+}
+
+int EventBus::findPending(EventType type, bool sameType) const {
+    // 전파 중인 head 슬롯은 건너뜀
+    int first = _dispatching ? 1 : 0;
+
+    for (int offset = first; offset < _queueCount; offset++) {
+        EventType pending = _eventQueue[(_queueHead + offset) % EVENT_QUEUE_SIZE].type;
+        if (sameType) {
+            if (pending == type) {
+                return offset;
+            }
+        } else if (pending != type && _policies[pending] != POLICY_NEVER_DROP) {
+            return offset;
+        }
+    }
+    return -1;
+}
+
+void EventBus::removeAt(int offset) {
+    EventType type = _eventQueue[(_queueHead + offset) % EVENT_QUEUE_SIZE].type;
+
+    // 뒤쪽 이벤트를 한 칸씩 당김 (포화 시에만 발생, 최대 15회 복사)
+    for (int i = offset; i < _queueCount - 1; i++) {
+        _eventQueue[(_queueHead + i) % EVENT_QUEUE_SIZE] =
+            _eventQueue[(_queueHead + i + 1) % EVENT_QUEUE_SIZE];
+#if EVENT_BUS_PROFILE
+        _enqueueMicros[(_queueHead + i) % EVENT_QUEUE_SIZE] =
+            _enqueueMicros[(_queueHead + i + 1) % EVENT_QUEUE_SIZE];
+#endif
+    }
+#if EVENT_BUS_PROFILE
+    _typeDropped[type]++;
+#endif
+
+    _queueTail = (_queueTail + EVENT_QUEUE_SIZE - 1) % EVENT_QUEUE_SIZE;
+    _queueCount--;
+    trackPop(type);
+
+    // 이번 update() 처리 대상이었던 이벤트면 예산에서도 제외
+    if (offset < _batchRemaining) {
+        _batchRemaining--;
+    }
+}
+
+void EventBus::writeSlot(Event& slot, EventType type, const void* payload, size_t size) {
+    slot.type = type;
+    slot.timestamp = millis();
+    slot.size = (uint8_t)size;
+    slot.flags = 0;
+    if (size > 0) {
+        memcpy(slot.payload, payload, size);
+    }
+}
+
+void EventBus::trackPush(EventType type) {
+    if (_pendingCount[type]++ == 0 && _policies[type] == POLICY_NEVER_DROP) {
+        _reservedFree--;
+    }
+}
+
+void EventBus::trackPop(EventType type) {
+    if (--_pendingCount[type] == 0 && _policies[type] == POLICY_NEVER_DROP) {
+        _reservedFree++;
+    }
+}
+
+void EventBus::resetQueue() {
+    _queueHead = 0;
+    _queueTail = 0;
+    _queueCount = 0;
+    _dispatching = false;
+    _batchRemaining = 0;
+
+    _reservedFree = 0;
+    for (int type = 0; type < EVENT_TYPE_COUNT; type++) {
+        _pendingCount[type] = 0;
+        if (_policies[type] == POLICY_NEVER_DROP) {
+            _reservedFree++;
+        }
+    }
+}
+
+int EventBus::addTimer(EventType type, const void* payload, size_t size,
+                       uint32_t delayMs, bool periodic) {
+    if (type < 0 || type >= EVENT_TYPE_COUNT || size > EVENT_PAYLOAD_SIZE) {
+        return EVENT_TIMER_NONE;
+    }
+
+    for (uint8_t id = 0; id < EVENT_TIMER_COUNT; id++) {
+        Timer& timer = _timers[id];
+        if (timer.active) {
+            continue;
+        }
+
+        // 첫 만료만 틱에 반영되지 않은 경과 시간까지 더해 올림 - 요청보다 일찍 발행되지 않음
+        // 주기는 틱 경계 기준이라 경과 시간을 넣으면 매 주기가 1틱씩 길어짐
+        // 올림 합산은 64비트 (delayMs가 UINT32_MAX 근처면 32비트 덧셈이 넘쳐 바로 만료됨)
+        uint32_t pendingMs = millis() - _timerLastMs;
+        uint32_t ticks = (uint32_t)(((uint64_t)delayMs + pendingMs + EVENT_TIMER_TICK_MS - 1) /
+                                    EVENT_TIMER_TICK_MS);
+        if (ticks == 0) {
+            ticks = 1;
+        }
+        uint32_t periodTicks = 0;
+        if (periodic) {
+            periodTicks = (uint32_t)(((uint64_t)delayMs + EVENT_TIMER_TICK_MS - 1) /
+                                     EVENT_TIMER_TICK_MS);
+            if (periodTicks == 0) {
+                periodTicks = 1;
+            }
+        }
+
+        timer.expire = _timerNow + ticks;
+        timer.period = periodTicks;
+        timer.type = (uint8_t)type;
+        timer.size = (uint8_t)size;
+        if (size > 0) {
+            memcpy(timer.payload, payload, size);
+        }
+        timer.active = true;
+        linkTimer(id);
+        return id;
+    }
+
+    Serial.println(F("EventBus: No free timer slot"));
+    return EVENT_TIMER_NONE;
+}
+
+void EventBus::advanceTimers() {
+    uint32_t now = millis();
+    uint32_t elapsedTicks = (now - _timerLastMs) / EVENT_TIMER_TICK_MS;
+    if (elapsedTicks == 0) {
+        return;
+    }
+
+    // 부분 틱은 남겨둠 (누적 오차 없음)
+    _timerLastMs += elapsedTicks * EVENT_TIMER_TICK_MS;
+    _timerNow += elapsedTicks;
+
+    // 지나간 틱의 버킷만 확인 (한 바퀴 이상 밀렸으면 전체 한 번)
+    uint32_t visit = (elapsedTicks < EVENT_TIMER_WHEEL_SIZE) ? elapsedTicks : EVENT_TIMER_WHEEL_SIZE;
+    for (uint32_t i = 0; i < visit; i++) {
+        uint8_t bucket = (uint8_t)((_timerNow - i) % EVENT_TIMER_WHEEL_SIZE);
+
+        uint8_t id = _timerBuckets[bucket];
+        while (id != TIMER_END) {
+            Timer& timer = _timers[id];
+            uint8_t next = timer.next;
+
+            // 같은 버킷의 다음 바퀴 타이머는 건너뜀
+            if ((int32_t)(timer.expire - _timerNow) <= 0) {
+                unlinkTimer(id);
+                publishPayload((EventType)timer.type, timer.payload, timer.size);
+
+                if (timer.period > 0) {
+                    // 위상 유지, 여러 주기가 밀렸으면 지금부터 한 주기 뒤로
+                    timer.expire += timer.period;
+                    if ((int32_t)(timer.expire - _timerNow) <= 0) {
+                        timer.expire = _timerNow + timer.period;
+                    }
+                    linkTimer(id);
+                } else {
+                    timer.active = false;
+                }
+            }
+            id = next;
+        }
+    }
+}
+
+void EventBus::linkTimer(uint8_t id) {
+    uint8_t bucket = (uint8_t)(_timers[id].expire % EVENT_TIMER_WHEEL_SIZE);
+    _timers[id].next = _timerBuckets[bucket];
+    _timerBuckets[bucket] = id;
+}
+
+void EventBus::unlinkTimer(uint8_t id) {
+    uint8_t bucket = (uint8_t)(_timers[id].expire % EVENT_TIMER_WHEEL_SIZE);
+    uint8_t* link = &_timerBuckets[bucket];
+    while (*link != TIMER_END) {
+        if (*link == id) {
+            *link = _timers[id].next;
+            return;
+        }
+        link = &_timers[*link].next;
+    }
+}
+
+void EventBus::resetTimers() {
+    for (int i = 0; i < EVENT_TIMER_COUNT; i++) {
+        _timers[i].active = false;
+        _timers[i].next = TIMER_END;
+    }
+    for (int i = 0; i < EVENT_TIMER_WHEEL_SIZE; i++) {
+        _timerBuckets[i] = TIMER_END;
+    }
+}
+
+void EventBus::invokeSubscriber(EventType type, uint8_t index, const Event& event) {
+    Subscriber& sub = _subscribers[type][index];
+
+#if EVENT_BUS_PROFILE
+    uint32_t startCycles = ESP.getCycleCount();
+    sub.callback(event, sub.userData);
+    uint32_t cycles = ESP.getCycleCount() - startCycles;
+
+    // 4배 간격 버킷 (1K 미만, 4K 미만, ... 마지막은 나머지)
+    uint8_t bucket = 0;
+    if (cycles >= 1024) {
+        bucket = (uint8_t)((31 - __builtin_clz(cycles) - 10) / 2 + 1);
+        if (bucket >= EVENT_PROFILE_BUCKETS) {
+            bucket = EVENT_PROFILE_BUCKETS - 1;
+        }
+    }
+
+    CallbackStats& stats = _callbackStats[type][index];
+    stats.calls++;
+    if (cycles > stats.maxCycles) {
+        stats.maxCycles = cycles;
+    }
+    if (stats.histogram[bucket] < UINT16_MAX) {
+        stats.histogram[bucket]++;
+    }
+#else
+    sub.callback(event, sub.userData);
+#endif
+}
+
+#if EVENT_BUS_PROFILE
+EventBus::TypeStats EventBus::getTypeStats(EventType type) const {
+    TypeStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (type < 0 || type >= EVENT_TYPE_COUNT) {
+        return stats;
+    }
+
+    stats.published = _typePublished[type];
+    stats.coalesced = _typeCoalesced[type];
+    stats.dropped = _typeDropped[type];
+    stats.dispatched = _typeDispatched[type];
+    stats.residenceMaxUs = _residenceMaxUs[type];
+    stats.residenceAvgUs = (_typeDispatched[type] > 0)
+        ? _residenceTotalUs[type] / _typeDispatched[type] : 0;
+    stats.pendingHighWater = _pendingHighWater[type];
+    return stats;
+}
+
+EventBus::CallbackStats EventBus::getCallbackStats(EventType type, uint8_t index) const {
+    if (type < 0 || type >= EVENT_TYPE_COUNT || index >= MAX_SUBSCRIBERS) {
+        CallbackStats empty;
+        memset(&empty, 0, sizeof(empty));
+        return empty;
+    }
+    return _callbackStats[type][index];
+}
+
+void EventBus::resetStats() {
+    memset(_typePublished, 0, sizeof(_typePublished));
+    memset(_typeCoalesced, 0, sizeof(_typeCoalesced));
+    memset(_typeDropped, 0, sizeof(_typeDropped));
+    memset(_typeDispatched, 0, sizeof(_typeDispatched));
+    memset(_residenceMaxUs, 0, sizeof(_residenceMaxUs));
+    memset(_residenceTotalUs, 0, sizeof(_residenceTotalUs));
+    memset(_pendingHighWater, 0, sizeof(_pendingHighWater));
+    memset(_callbackStats, 0, sizeof(_callbackStats));
+    _queueHighWater = 0;
+}
+
+void EventBus::printStats(Print& out) const {
+    uint32_t cyclesPerUs = ESP.getCpuFreqMHz();
+
+    out.print(F("[EventBus] queue high-water "));
+    out.print(_queueHighWater);
+    out.print('/');
+    out.println(EVENT_QUEUE_SIZE);
+
+    for (int type = 0; type < EVENT_TYPE_COUNT; type++) {
+        if (_typePublished[type] == 0 && _typeDispatched[type] == 0) {
+            continue;
+        }
+        TypeStats stats = getTypeStats((EventType)type);
+
+        out.print(F("[EventBus] type "));
+        out.print(type);
+        out.print(F(": pub "));
+        out.print(stats.published);
+        out.print(F(" coal "));
+        out.print(stats.coalesced);
+        out.print(F(" drop "));
+        out.print(stats.dropped);
+        out.print(F(" disp "));
+        out.print(stats.dispatched);
+        out.print(F(" hw "));
+        out.print(stats.pendingHighWater);
+        out.print(F(" wait avg/max "));
+        out.print(stats.residenceAvgUs);
+        out.print('/');
+        out.print(stats.residenceMaxUs);
+        out.println(F(" us"));
+
+        for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
+            const CallbackStats& cb = _callbackStats[type][i];
+            if (cb.calls == 0) {
+                continue;
+            }
+            out.print(F("  sub "));
+            out.print(i);
+            out.print(F(": calls "));
+            out.print(cb.calls);
+            out.print(F(" max "));
+            out.print(cb.maxCycles / cyclesPerUs);
+            out.print(F(" us, hist"));
+            for (int b = 0; b < EVENT_PROFILE_BUCKETS; b++) {
+                out.print(' ');
+                out.print(cb.histogram[b]);
+            }
+            out.println();
         }
     }
 }
+#endif
@@ -6,6 +6,8 @@
 #define ARTHUR_EVENT_BUS_H
 
 #include <Arduino.h>
+#include <atomic>
+#include <type_traits>
 
 // 최대 이벤트 타입 수
 #define MAX_EVENT_TYPES 8
@@ -13,6 +15,29 @@
 // 최대 구독자 수 (이벤트 타입당)
 #define MAX_SUBSCRIBERS 4
 
+// 이벤트 payload 최대 크기 (큐 슬롯마다 인라인 저장, 슬롯 16개 x 36바이트)
+#define EVENT_PAYLOAD_SIZE 24
+
+// 타이머 (publishAfter/publishEvery) - 최대 개수, 휠 버킷 수, 틱 해상도
+#define EVENT_TIMER_COUNT 8
+#define EVENT_TIMER_WHEEL_SIZE 16
+#define EVENT_TIMER_TICK_MS 10
+
+// 타이머 ID 없음 (publishAfter/publishEvery 실패)
+#define EVENT_TIMER_NONE -1
+
+// 프로파일링 (발행/전파 수, 큐 체류 시간, 콜백 사이클 히스토그램) - ARTHUR_DEBUG=0이면 제외
+#ifndef EVENT_BUS_PROFILE
+#if defined(ARTHUR_DEBUG) && ARTHUR_DEBUG
+#define EVENT_BUS_PROFILE 1
+#else
+#define EVENT_BUS_PROFILE 0
+#endif
+#endif
+
+// 콜백 사이클 히스토그램 버킷 수 (경계: 1K, 4K, 16K ... 사이클, 4배씩)
+#define EVENT_PROFILE_BUCKETS 8
+
 // 이벤트 타입 열거형
 enum EventType {
     WIFI_CONNECTED,      // WiFi 연결 완료
@@ -20,17 +45,52 @@ enum EventType {
     TIME_SYNCED,         // NTP 시간 동기화 완료
     SENSOR_UPDATED,      // 센서 데이터 업데이트
     WEATHER_UPDATED,     // 날씨 정보 업데이트
-    // 예비 타입 (최대 8개)
-    EVENT_TYPE_RESERVED_1,
-    EVENT_TYPE_RESERVED_2,
-    EVENT_TYPE_COUNT     // 항상 마지막에 위치
+    CONFIG_CHANGED,      // 설정 변경 (payload: Cfg::Id, ConfigManager::changedKey()로 읽기)
+    BUTTON_PRESSED,      // 버튼 입력 (publishFromISR, payload: uint32_t)
+    EVENT_TYPE_COUNT     // 항상 마지막에 위치 (최대 8개)
 };
 
+// 큐 포화 시 처리 정책 (이벤트 타입별)
+enum EventPolicy : uint8_t {
+    POLICY_DROP_NEWEST,  // 새 이벤트를 버림 (기본)
+    POLICY_DROP_OLDEST,  // 같은 타입의 가장 오래된 대기 이벤트를 버리고 추가
+    POLICY_COALESCE,     // 같은 타입이 대기 중이면 그 슬롯을 최신 값으로 교체 (상태형 이벤트)
+    POLICY_NEVER_DROP    // 타입당 1슬롯 예약 + 포화 시 다른 타입의 오래된 이벤트를 밀어냄
+};
+
+// Event::flags 비트
+#define EVENT_FLAG_RETAINED 0x01   // 보관 슬롯에서 다시 전달된 이벤트
+
 // 이벤트 데이터 구조체
+// @MX:NOTE: [인라인 payload] 발행 시 큐 슬롯에 값으로 복사 - 발행자 스택/멤버 수명과 무관
 struct Event {
     EventType type;              // 이벤트 타입
     unsigned long timestamp;     // 발생 시각 (millis())
-    const void* data;            // 부가 데이터 (선택 사항)
+    uint8_t size;                // payload 바이트 (0이면 없음)
+    uint8_t flags;               // EVENT_FLAG_* (payload 정렬 패딩 자리 - 크기 변화 없음)
+    alignas(4) uint8_t payload[EVENT_PAYLOAD_SIZE];  // 부가 데이터 (선택 사항)
+
+    Event() : type(EVENT_TYPE_COUNT), timestamp(0), size(0), flags(0) {}
+
+    /**
+     * @brief 보관 이벤트 여부 (retained()/subscribe(deliverRetained)/requestRetained() 재전달)
+     *
+     * 큐에서 처음 전파될 때는 false
+     */
+    bool isRetained() const { return (flags & EVENT_FLAG_RETAINED) != 0; }
+
+    /**
+     * @brief payload를 T로 읽기
+     *
+     * @return const T* payload (크기가 sizeof(T)와 다르면 nullptr)
+     */
+    template <typename T>
+    const T* as() const {
+        static_assert(std::is_trivially_copyable<T>::value, "Event payload must be trivially copyable");
+        static_assert(sizeof(T) <= EVENT_PAYLOAD_SIZE, "Event payload exceeds EVENT_PAYLOAD_SIZE");
+        static_assert(alignof(T) <= 4, "Event payload alignment exceeds 4");
+        return (size == sizeof(T)) ? reinterpret_cast<const T*>(payload) : nullptr;
+    }
 };
 
 // 이벤트 콜백 함수 포인터 타입
@@ -51,6 +111,10 @@ struct Subscriber {
  * - 정적 할당만 사용 (new/malloc 금지)
  * - String 클래스 미사용
  * - 최대 8개 이벤트 타입, 타입당 4개 구독자 지원
+ * - 타입별 큐 정책 (EventPolicy) - 센서 버스트가 일회성 이벤트를 막지 않도록 함
+ * - 타입별 마지막 이벤트 보관 (retained) - 늦게 구독한 모듈도 현재 상태를 바로 받음
+ * - 인터럽트 전용 링 (publishFromISR) - update()에서 일반 큐로 옮겨 전파
+ * - 지연/주기 발행 (publishAfter/publishEvery) - 해시 타이머 휠, millis() 롤오버 안전
  */
 class EventBus {
 public:
@@ -68,10 +132,12 @@ public:
      * @param type 구독할 이벤트 타입
      * @param callback 이벤트 발생 시 호출될 함수
      * @param userData 콜백에 전달할 사용자 데이터 (선택 사항)
+     * @param deliverRetained true면 보관된 마지막 이벤트를 다음 update()에서 이 구독자에게 전달
      * @return true 구독 성공
      * @return false 구독 실패 (구독자 만료 또는 잘못된 타입)
      */
-    bool subscribe(EventType type, EventCallback callback, void* userData = nullptr);
+    bool subscribe(EventType type, EventCallback callback, void* userData = nullptr,
+                   bool deliverRetained = false);
 
     /**
      * @brief 이벤트 발행 (비동기)
@@ -85,15 +151,217 @@ public:
      */
     bool publish(const Event& event);
 
+    /**
+     * @brief payload 없는 이벤트 발행
+     *
+     * @param type 발행할 이벤트 타입
+     * @return true 이벤트 큐에 추가 성공
+     * @return false 큐가 가득 참
+     */
+    bool publish(EventType type);
+
+    /**
+     * @brief payload를 큐 슬롯에 복사해 발행
+     *
+     * 예: gEventBus.publish(SENSOR_UPDATED, data); -> event.as<SensorData>()
+     *
+     * @param type 발행할 이벤트 타입
+     * @param payload 복사할 값 (EVENT_PAYLOAD_SIZE 이하, trivially copyable)
+     * @return true 이벤트 큐에 추가 성공
+     * @return false 큐가 가득 참
+     */
+    template <typename T>
+    bool publish(EventType type, const T& payload) {
+        static_assert(std::is_trivially_copyable<T>::value, "Event payload must be trivially copyable");
+        static_assert(sizeof(T) <= EVENT_PAYLOAD_SIZE, "Event payload exceeds EVENT_PAYLOAD_SIZE");
+        static_assert(alignof(T) <= 4, "Event payload alignment exceeds 4");
+        return publishPayload(type, &payload, sizeof(T));
+    }
+
+    /**
+     * @brief 인터럽트 핸들러에서 이벤트 발행 (IRAM, 잠금 없음)
+     *
+     * 전용 링 슬롯에 기록하고 인덱스만 갱신 - 다음 update()에서 일반 큐로 옮김
+     * publish()는 ISR에서 호출하면 큐 인덱스가 깨지므로 반드시 이 함수를 사용
+     *
+     * 예: void IRAM_ATTR onButton() { gEventBus.publishFromISR(BUTTON_PRESSED, millis()); }
+     *     attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButton, FALLING);
+     *
+     * @MX:WARN: [단일 생산자] 링은 ISR 하나(또는 서로 중첩되지 않는 ISR들)에서만 발행해야 함
+     *
+     * @param type 발행할 이벤트 타입
+     * @param value payload (event.as<uint32_t>()로 읽기)
+     * @return true 링에 추가 성공
+     * @return false 링이 가득 참 (isrDropCount() 증가)
+     */
+    bool publishFromISR(EventType type, uint32_t value = 0);
+
+    /**
+     * @brief ISR 링이 가득 차서 버려진 이벤트 수 (누적)
+     */
+    uint32_t isrDropCount() const { return _isrDropCount; }
+
+    /**
+     * @brief 이벤트 타입의 큐 정책 변경
+     *
+     * 기본값은 event_bus.cpp의 DEFAULT_POLICIES
+     * POLICY_NEVER_DROP 예약 슬롯은 이벤트를 발행하기 전(setup)에 정해야 함
+     *
+     * @param type 대상 이벤트 타입
+     * @param policy 적용할 정책
+     * @return true 변경 성공
+     * @return false 잘못된 타입
+     */
+    bool setPolicy(EventType type, EventPolicy policy);
+
+    /**
+     * @brief 이벤트 타입의 큐 정책 조회
+     */
+    EventPolicy getPolicy(EventType type) const;
+
+    /**
+     * @brief 보관된 마지막 이벤트 조회
+     *
+     * timestamp는 원래 발행 시각이므로 받는 쪽에서 나이를 판단할 수 있음
+     *
+     * @param type 이벤트 타입
+     * @return const Event* 마지막으로 전파된 이벤트 (아직 없으면 nullptr)
+     */
+    const Event* retained(EventType type) const;
+
+    /**
+     * @brief 이미 구독한 콜백에 보관 이벤트를 다시 전달 요청
+     *
+     * 다음 update()에서 isRetained()가 true인 Event로 전달됨
+     * (Channel처럼 한 콜백이 여러 구독자를 대표할 때 새 구독자에게만 전달하는 데 사용)
+     *
+     * @return true 전달 예약됨
+     * @return false 보관 이벤트 없음 또는 구독하지 않은 콜백
+     */
+    bool requestRetained(EventType type, EventCallback callback);
+
+    /**
+     * @brief 큐 포화로 버려진 이벤트 수 (누적)
+     */
+    uint32_t dropCount() const { return _dropCount; }
+
+    /**
+     * @brief 대기 중인 이벤트에 합쳐진 발행 수 (누적)
+     */
+    uint32_t coalesceCount() const { return _coalesceCount; }
+
     /**
      * @brief 대기 중인 이벤트 처리
      *
-     * 큐에 있는 이벤트를 순차적으로 처리하고 등록된 콜백 호출
+     * 호출 시점에 큐에 있던 이벤트만 순차적으로 처리하고 등록된 콜백 호출
+     * 콜백이 발행한 이벤트는 다음 update()로 넘어감 (루프당 지연 상한)
      * loop() 함수에서 주기적으로 호출해야 함
      *
-     * @return int 처리된 이벤트 개수
+     * @MX:NOTE: [재진입] 콜백 안에서 update()를 호출하면 아무것도 하지 않고 0 반환
+     *
+     * @param maxEvents 최대 전파 개수 (0이면 제한 없음)
+     * @param maxMicros 시간 예산 (마이크로초, 0이면 제한 없음) - 최소 1개는 전파
+     * @return int 처리된 이벤트 개수 (남은 개수는 queuedCount())
+     */
+    int update(int maxEvents = 0, uint32_t maxMicros = 0);
+
+    /**
+     * @brief 전파 대기 중인 이벤트 수 (ISR 링 포함)
+     */
+    int queuedCount() const;
+
+    /**
+     * @brief 지연 발행 (한 번)
+     *
+     * delayMs 이후의 update()에서 발행 (EVENT_TIMER_TICK_MS 단위로 올림, 일찍 발행되지 않음)
+     *
+     * @param event 발행할 이벤트 (payload 포함, 값으로 복사)
+     * @param delayMs 지연 시간 (밀리초)
+     * @return int 타이머 ID (cancelTimer용), 슬롯이 없으면 EVENT_TIMER_NONE
+     */
+    int publishAfter(const Event& event, uint32_t delayMs);
+    int publishAfter(EventType type, uint32_t delayMs);
+
+    /**
+     * @brief 주기 발행
+     *
+     * periodMs마다 발행, 루프가 밀려 여러 주기를 놓치면 한 번만 발행하고 다음 주기로 맞춤
+     * (주기 이벤트는 COALESCE 정책 타입에 쓰는 것이 좋음)
+     *
+     * @param event 발행할 이벤트 (payload 포함, 값으로 복사)
+     * @param periodMs 주기 (밀리초, 첫 발행도 periodMs 후)
+     * @return int 타이머 ID (cancelTimer용), 슬롯이 없으면 EVENT_TIMER_NONE
      */
-    int update();
+    int publishEvery(const Event& event, uint32_t periodMs);
+    int publishEvery(EventType type, uint32_t periodMs);
+
+    /**
+     * @brief 타이머 취소
+     *
+     * @MX:WARN: [ID 재사용] 한 번 발행된 publishAfter 타이머의 ID는 바로 재사용될 수 있음
+     *
+     * @param timerId publishAfter/publishEvery가 반환한 ID
+     * @return true 취소됨
+     * @return false 없는 타이머
+     */
+    bool cancelTimer(int timerId);
+
+    /**
+     * @brief 다음 타이머까지 남은 시간
+     *
+     * loop()가 이 시간만큼 쉬어도 타이머 이벤트를 놓치지 않음
+     *
+     * @return uint32_t 밀리초 (0이면 지금 update() 필요, 타이머가 없으면 UINT32_MAX)
+     */
+    uint32_t nextTimerDelay() const;
+
+#if EVENT_BUS_PROFILE
+    // 이벤트 타입별 통계
+    struct TypeStats {
+        uint32_t published;       // publish 호출 수 (합치기/버림 포함)
+        uint32_t coalesced;       // 대기 슬롯에 합쳐진 수
+        uint32_t dropped;         // 큐 포화로 버려진 수
+        uint32_t dispatched;      // 전파된 수
+        uint32_t residenceMaxUs;  // 큐 체류 시간 최대 (발행 -> 전파 시작)
+        uint32_t residenceAvgUs;  // 큐 체류 시간 평균
+        uint8_t pendingHighWater; // 이 타입이 동시에 대기한 최대 수
+    };
+
+    // 구독자 콜백별 실행 시간 (ESP.getCycleCount())
+    struct CallbackStats {
+        uint32_t calls;
+        uint32_t maxCycles;
+        uint16_t histogram[EVENT_PROFILE_BUCKETS];  // 0: 1K 미만, i: 1K*4^(i-1) 이상, 마지막은 나머지 전부 (포화 카운트)
+    };
+
+    /**
+     * @brief 이벤트 타입 통계
+     */
+    TypeStats getTypeStats(EventType type) const;
+
+    /**
+     * @brief 구독자 콜백 통계
+     *
+     * @param type 이벤트 타입
+     * @param index 구독자 슬롯 (0 ~ MAX_SUBSCRIBERS-1, subscribe 순서)
+     */
+    CallbackStats getCallbackStats(EventType type, uint8_t index) const;
+
+    /**
+     * @brief 큐 전체 최대 점유 수
+     */
+    uint8_t queueHighWater() const { return _queueHighWater; }
+
+    /**
+     * @brief 통계 초기화
+     */
+    void resetStats();
+
+    /**
+     * @brief 통계를 사람이 읽는 형태로 출력 (예: gEventBus.printStats(Serial))
+     */
+    void printStats(Print& out) const;
+#endif
 
     /**
      * @brief 구독 취소
@@ -119,12 +387,154 @@ private:
     int _queueTail;      // 큐의 쓰기 위치
     int _queueCount;     // 큐에 있는 이벤트 수
 
+    // 타입별 정책과 대기 중인 이벤트 수
+    EventPolicy _policies[EVENT_TYPE_COUNT];
+    uint8_t _pendingCount[EVENT_TYPE_COUNT];
+    int _reservedFree;   // 아직 쓰지 않은 예약 슬롯 수 (대기 이벤트 없는 NEVER_DROP 타입 수)
+
+    // 타입별 마지막 전파 이벤트 (retained)
+    // @MX:NOTE: [retained] 전파 시점에 보관 - 큐에 남은 이벤트와 중복 전달되지 않음
+    Event _retained[EVENT_TYPE_COUNT];
+    uint8_t _retainedValid;                          // 비트: 타입별 보관 여부 (MAX_EVENT_TYPES <= 8)
+    uint8_t _retainedPending[EVENT_TYPE_COUNT];      // 비트: 전달 대기 중인 구독자 인덱스 (MAX_SUBSCRIBERS <= 8)
+
+    uint32_t _dropCount;
+    uint32_t _coalesceCount;
+
+    // 인터럽트 전용 링 (단일 생산자/단일 소비자)
+    // @MX:NOTE: [ISR 링] head는 ISR만, tail은 update()만 기록 - 슬롯 기록 후 인덱스 저장 하나로 공개
+    static const uint8_t ISR_QUEUE_SIZE = 8;  // 2의 거듭제곱
+    static_assert((ISR_QUEUE_SIZE & (ISR_QUEUE_SIZE - 1)) == 0, "ISR_QUEUE_SIZE must be a power of two");
+    struct IsrEvent {
+        uint8_t type;
+        uint32_t value;
+    };
+    IsrEvent _isrQueue[ISR_QUEUE_SIZE];
+    volatile uint8_t _isrHead;
+    volatile uint8_t _isrTail;
+    volatile uint32_t _isrDropCount;
+
     bool _initialized;
+    bool _updating;      // update() 실행 중 (재진입 방지)
+    bool _dispatching;   // update()가 head 슬롯을 전파 중 (그 슬롯은 교체/제거 금지)
+    int _batchRemaining; // 이번 update() 시작 시점에 있던 이벤트 중 남은 수
+
+    // 해시 타이머 휠
+    // @MX:NOTE: [타이머 휠] 만료 틱은 절대값(expire), 버킷 = expire % WHEEL_SIZE
+    // 틱 카운터는 millis() 차이를 누적하므로 49일 롤오버와 무관, 밀린 틱은 버킷을 최대 한 바퀴만 훑음
+    struct Timer {
+        uint32_t expire;     // 만료 틱 (_timerNow 기준, 랩 안전 비교)
+        uint32_t period;     // 주기 틱 (0이면 한 번)
+        uint8_t type;        // EventType
+        uint8_t size;        // payload 바이트
+        uint8_t next;        // 같은 버킷의 다음 타이머 (TIMER_END면 끝)
+        bool active;
+        alignas(4) uint8_t payload[EVENT_PAYLOAD_SIZE];
+    };
+    static const uint8_t TIMER_END = 0xFF;
+    static_assert((EVENT_TIMER_WHEEL_SIZE & (EVENT_TIMER_WHEEL_SIZE - 1)) == 0,
+                  "EVENT_TIMER_WHEEL_SIZE must be a power of two (tick counter wraps)");
+    Timer _timers[EVENT_TIMER_COUNT];
+    uint8_t _timerBuckets[EVENT_TIMER_WHEEL_SIZE];  // 버킷별 첫 타이머
+    uint32_t _timerNow;      // 현재 틱
+    uint32_t _timerLastMs;   // _timerNow에 해당하는 millis()
+
+#if EVENT_BUS_PROFILE
+    // @MX:NOTE: [프로파일] 슬롯별 발행 시각은 큐와 나란히 두고 removeAt()에서 같이 당김
+    uint32_t _enqueueMicros[EVENT_QUEUE_SIZE];
+    uint32_t _typePublished[EVENT_TYPE_COUNT];
+    uint32_t _typeCoalesced[EVENT_TYPE_COUNT];
+    uint32_t _typeDropped[EVENT_TYPE_COUNT];
+    uint32_t _typeDispatched[EVENT_TYPE_COUNT];
+    uint32_t _residenceMaxUs[EVENT_TYPE_COUNT];
+    uint32_t _residenceTotalUs[EVENT_TYPE_COUNT];
+    uint8_t _pendingHighWater[EVENT_TYPE_COUNT];
+    uint8_t _queueHighWater;
+    CallbackStats _callbackStats[EVENT_TYPE_COUNT][MAX_SUBSCRIBERS];
+#endif
+
+    /**
+     * @brief 큐 슬롯 확보 후 payload 복사 (내부용)
+     */
+    bool publishPayload(EventType type, const void* payload, size_t size);
+
+    /**
+     * @brief 정책을 반영한 큐 여유 확인 (내부용)
+     */
+    bool hasRoom(EventType type) const;
+
+    /**
+     * @brief 대기 중인 이벤트 검색 (내부용)
+     *
+     * @param type 찾을 타입 (sameType=false면 이 타입이 아닌 비예약 이벤트 검색)
+     * @return int head 기준 오프셋, 없으면 -1
+     */
+    int findPending(EventType type, bool sameType) const;
+
+    /**
+     * @brief head 기준 오프셋의 이벤트 제거 후 뒤쪽을 당김 (내부용)
+     */
+    void removeAt(int offset);
+
+    /**
+     * @brief 슬롯에 이벤트 기록 (내부용)
+     */
+    void writeSlot(Event& slot, EventType type, const void* payload, size_t size);
+
+    /**
+     * @brief 대기 수/예약 슬롯 갱신 (내부용)
+     */
+    void trackPush(EventType type);
+    void trackPop(EventType type);
+
+    /**
+     * @brief 큐와 대기 수 초기화 (내부용)
+     */
+    void resetQueue();
 
     /**
      * @brief 콜백 호출 (내부용)
      */
     void dispatchEvent(const Event& event);
+
+    /**
+     * @brief ISR 링의 이벤트를 일반 큐로 옮김 (내부용)
+     */
+    void drainIsrQueue();
+
+    /**
+     * @brief 새 구독자에게 보관 이벤트 전달 (내부용)
+     *
+     * @return int 전달한 이벤트 타입 수
+     */
+    int deliverRetained();
+
+    /**
+     * @brief 타이머 등록 (내부용)
+     */
+    int addTimer(EventType type, const void* payload, size_t size,
+                 uint32_t delayMs, bool periodic);
+
+    /**
+     * @brief 틱 진행 후 만료 타이머 발행 (내부용)
+     */
+    void advanceTimers();
+
+    /**
+     * @brief 버킷 연결/해제 (내부용)
+     */
+    void linkTimer(uint8_t id);
+    void unlinkTimer(uint8_t id);
+
+    /**
+     * @brief 모든 타이머 취소 (내부용)
+     */
+    void resetTimers();
+
+    /**
+     * @brief 구독자 콜백 호출 (프로파일 빌드에서는 사이클 측정)
+     */
+    void invokeSubscriber(EventType type, uint8_t index, const Event& event);
 };
 
 // 전역 인스턴스 (extern)
@@ -0,0 +1,299 @@
+// @MX:NOTE: [AUTO] 타입 채널 - payload 타입으로 EventBus 이벤트를 발행/구독
+// @MX:ANCHOR: [AUTO] 모듈 간 타입 안전 데이터 전달
+// @MX:REASON: fan_in >= 3 (SensorModule, WeatherModule, ClockModule)
+
+#ifndef ARTHUR_EVENT_CHANNEL_H
+#define ARTHUR_EVENT_CHANNEL_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "event_bus.h"
+
+/**
+ * @brief 채널 선언 (payload 타입 -> 이벤트 타입, 최대 구독자 수)
+ *
+ * 선언되지 않은 타입으로 Channel<T>를 쓰면 컴파일 오류
+ * 전역 네임스페이스에서 payload 타입 선언 뒤에 사용:
+ *   EVENT_CHANNEL(SensorData, SENSOR_UPDATED, 2);
+ *
+ * @MX:WARN: [1:1 매핑] 이벤트 타입 하나에 채널 하나 - 같은 타입을 두 payload로 선언하면 as<T>()가 걸러냄
+ */
+template <typename T>
+struct ChannelTraits;
+
+#define EVENT_CHANNEL(TPayload, EVENT_TYPE, MAX_SUBS)               \
+    template <>                                                    \
+    struct ChannelTraits<TPayload> {                               \
+        static constexpr EventType type = EVENT_TYPE;              \
+        static constexpr uint8_t maxSubscribers = MAX_SUBS;        \
+    }
+
+/**
+ * @brief 타입 채널
+ *
+ * EventBus 위의 얇은 계층 - 큐/정책/retained/타이머는 EventBus가 그대로 처리
+ * - publish(const T&) / 콜백 void(const T&, void*) 로 payload 타입을 컴파일 타임에 고정
+ * - 구독자 배열은 채널마다 maxSubscribers 크기로 정적 할당, 빈 칸 없이 앞에서부터 채움
+ * - EventBus에는 채널 전체가 구독자 1개로 등록됨 (첫 구독 시)
+ *
+ * 예: Channel<SensorData>::subscribe(onSensor, this, true);
+ *     Channel<SensorData>::publish(data);
+ */
+template <typename T>
+class Channel {
+public:
+    typedef ChannelTraits<T> Traits;
+    typedef void (*Callback)(const T& value, void* userData);
+
+    static_assert(Traits::maxSubscribers > 0 && Traits::maxSubscribers <= 32,
+                  "Channel maxSubscribers must be 1..32");
+    static_assert(std::is_trivially_copyable<T>::value, "Channel payload must be trivially copyable");
+    static_assert(sizeof(T) <= EVENT_PAYLOAD_SIZE, "Channel payload exceeds EVENT_PAYLOAD_SIZE");
+    static_assert(alignof(T) <= 4, "Channel payload alignment exceeds 4");
+
+    /**
+     * @brief 구독 필터 (멤버 포인터 기반, 선언형)
+     *
+     * Channel이 콜백 호출 전에 직접 평가 - 걸러진 이벤트는 구독자 콜백을 부르지 않음
+     * 조건은 모두 만족해야 통과 (AND), 필드는 payload를 T로 읽어 멤버 포인터로 접근
+     *
+     * 예: Channel<SensorData>::Filter().whenTrue(&SensorData::valid)
+     *                                  .minDelta(&SensorData::temperature, 0.1f)
+     *
+     * @MX:NOTE: [델타 필터] 마지막으로 통과시킨 값을 구독자마다 기억 - 임계값 미만 변화는 버림
+     */
+    class Filter {
+    public:
+        Filter()
+            : _flag(nullptr)
+            , _deltaField(nullptr)
+            , _source(nullptr)
+            , _hasLast(false)
+            , _delta(0)
+            , _lastValue(0)
+            , _sourceMask(0)
+        {
+        }
+
+        // bool 필드가 true일 때만 전달
+        Filter& whenTrue(bool T::*field) {
+            _flag = field;
+            return *this;
+        }
+
+        // float 필드가 마지막 전달 값보다 delta 이상 바뀌었을 때만 전달
+        Filter& minDelta(float T::*field, float delta) {
+            _deltaField = field;
+            _delta = delta;
+            return *this;
+        }
+
+        // uint8_t 소스 ID 필드(0~31)가 mask의 비트(1 << id)에 있을 때만 전달
+        Filter& fromSources(uint8_t T::*field, uint32_t mask) {
+            _source = field;
+            _sourceMask = mask;
+            return *this;
+        }
+
+        /**
+         * @brief 값 평가 (통과하면 델타 기준값 갱신)
+         */
+        bool pass(const T& value) {
+            if (_flag != nullptr && !(value.*_flag)) {
+                return false;
+            }
+            if (_source != nullptr) {
+                uint8_t source = value.*_source;
+                if (source >= 32 || (_sourceMask & (1UL << source)) == 0) {
+                    return false;
+                }
+            }
+            if (_deltaField != nullptr) {
+                float current = value.*_deltaField;
+                if (_hasLast && fabsf(current - _lastValue) < _delta) {
+                    return false;
+                }
+                _lastValue = current;
+                _hasLast = true;
+            }
+            return true;
+        }
+
+    private:
+        bool T::*_flag;
+        float T::*_deltaField;
+        uint8_t T::*_source;
+        bool _hasLast;          // _lastValue 유효 여부
+        float _delta;
+        float _lastValue;
+        uint32_t _sourceMask;
+    };
+
+    /**
+     * @brief 채널 구독
+     *
+     * @param callback payload를 받을 함수
+     * @param userData 콜백에 전달할 사용자 데이터
+     * @param deliverRetained true면 마지막 값을 다음 update()에서 이 구독자에게만 전달
+     * @param filter 콜백 전에 평가할 조건 (기본: 모두 전달)
+     * @return true 구독 성공
+     * @return false 채널 구독자 초과 또는 EventBus 구독 실패
+     */
+    static bool subscribe(Callback callback, void* userData = nullptr, bool deliverRetained = false,
+                          const Filter& filter = Filter()) {
+        if (callback == nullptr || _count >= Traits::maxSubscribers) {
+            return false;
+        }
+        if (_count == 0 && !gEventBus.subscribe(Traits::type, onEvent, nullptr)) {
+            return false;
+        }
+
+        _entries[_count].callback = callback;
+        _entries[_count].userData = userData;
+        _entries[_count].filter = filter;
+        if (deliverRetained && gEventBus.requestRetained(Traits::type, onEvent)) {
+            _retainedPending |= (1UL << _count);
+        }
+        _count++;
+        return true;
+    }
+
+    /**
+     * @brief 구독 취소 (마지막 구독자를 빈 자리로 옮겨 배열을 빈 칸 없이 유지)
+     *
+     * 콜백 안에서 호출해도 됨 - 전파 중에는 자리만 비우고 전파가 끝난 뒤 옮김
+     */
+    static void unsubscribe(Callback callback) {
+        for (uint8_t i = 0; i < _count; i++) {
+            if (_entries[i].callback != callback) {
+                continue;
+            }
+
+            _retainedPending &= ~(1UL << i);
+            if (_dispatching) {
+                // 지금 옮기면 뒤쪽 구독자가 이미 지난 자리로 가서 이번 이벤트를 놓침
+                _entries[i].callback = nullptr;
+                _removed++;
+                return;
+            }
+            removeAt(i);
+            return;
+        }
+    }
+
+    /**
+     * @brief 값 발행 (EventBus 큐에 복사)
+     */
+    static bool publish(const T& value) {
+        return gEventBus.publish(Traits::type, value);
+    }
+
+    /**
+     * @brief 일정 시간 후 값 발행
+     *
+     * @return int 타이머 ID (EventBus::cancelTimer용)
+     */
+    static int publishAfter(const T& value, uint32_t delayMs) {
+        Event event;
+        event.type = Traits::type;
+        memcpy(event.payload, &value, sizeof(T));
+        event.size = sizeof(T);
+        return gEventBus.publishAfter(event, delayMs);
+    }
+
+    /**
+     * @brief 마지막으로 전파된 값
+     *
+     * @return const T* 값 (아직 없으면 nullptr)
+     */
+    static const T* retained() {
+        const Event* event = gEventBus.retained(Traits::type);
+        return (event != nullptr) ? event->as<T>() : nullptr;
+    }
+
+    /**
+     * @brief 현재 구독자 수
+     */
+    static uint8_t subscriberCount() { return _count - _removed; }
+
+private:
+    struct Entry {
+        Callback callback;
+        void* userData;
+        Filter filter;
+    };
+
+    static Entry _entries[Traits::maxSubscribers];
+    static uint8_t _count;             // 전파 중 비운 자리 포함
+    static uint8_t _removed;           // 전파 중 구독 취소로 비운 자리 수
+    static bool _dispatching;
+    static uint32_t _retainedPending;  // 비트: retained를 아직 받지 않은 구독자
+
+    // i번 구독자 제거 (마지막 구독자를 옮겨 채움)
+    static void removeAt(uint8_t i) {
+        uint8_t last = _count - 1;
+        _entries[i] = _entries[last];
+        if (_retainedPending & (1UL << last)) {
+            _retainedPending = (_retainedPending & ~(1UL << last)) | (1UL << i);
+        }
+        _count = last;
+
+        if (_count == 0) {
+            gEventBus.unsubscribe(Traits::type, onEvent);
+        }
+    }
+
+    // EventBus 콜백 - payload 타입 확인 후 구독자 배열을 그대로 순회
+    static void onEvent(const Event& event, void* userData) {
+        (void)userData;
+
+        const T* value = event.as<T>();
+        if (value == nullptr) {
+            return;
+        }
+
+        // requestRetained() 재전달은 요청한 구독자에게만
+        uint32_t targets = 0xFFFFFFFFUL;
+        if (event.isRetained()) {
+            targets = _retainedPending;
+            _retainedPending = 0;
+        }
+
+        // 필터는 인라인 비교 - 걸러진 구독자는 콜백 간접 호출 없음
+        _dispatching = true;
+        for (uint8_t i = 0; i < _count; i++) {
+            if ((targets & (1UL << i)) && _entries[i].callback != nullptr &&
+                _entries[i].filter.pass(*value)) {
+                _entries[i].callback(*value, _entries[i].userData);
+            }
+        }
+        _dispatching = false;
+
+        // 콜백에서 구독 취소된 자리 정리 (뒤에서부터 - 옮겨 오는 마지막 칸은 이미 확인됨)
+        if (_removed > 0) {
+            for (uint8_t i = _count; i > 0; i--) {
+                if (_entries[i - 1].callback == nullptr) {
+                    removeAt(i - 1);
+                }
+            }
+            _removed = 0;
+        }
+    }
+};
+
+template <typename T>
+typename Channel<T>::Entry Channel<T>::_entries[ChannelTraits<T>::maxSubscribers];
+
+template <typename T>
+uint8_t Channel<T>::_count = 0;
+
+template <typename T>
+uint8_t Channel<T>::_removed = 0;
+
+template <typename T>
+bool Channel<T>::_dispatching = false;
+
+template <typename T>
+uint32_t Channel<T>::_retainedPending = 0;
+
+#endif // ARTHUR_EVENT_CHANNEL_H
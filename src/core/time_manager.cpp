@@ -245,10 +245,5 @@ unsigned long TimeManager::getLastSyncTime() {
 
 void TimeManager::notifyTimeSynced() {
     // TIME_SYNCED 이벤트 발행
-    Event event;
-    event.type = TIME_SYNCED;
-    event.timestamp = millis();
-    event.data = nullptr;
-
-    gEventBus.publish(event);
+    gEventBus.publish(TIME_SYNCED);
 }
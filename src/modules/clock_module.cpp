@@ -5,8 +5,6 @@
 #include "../core/event_bus.h"
 #include "../include/arthur_pins.h"
 #include "../include/arthur_config.h"
-#include "weather_module.h"  // @MX:NOTE: WeatherData 구조체 사용을 위해 포함
-#include "sensor_module.h"   // @MX:NOTE: SensorData 구조체 사용을 위해 포함
 
 // 전역 포인터 정의 (이벤트 콜백용)
 ClockModule* gClockModulePtr = nullptr;
@@ -30,10 +28,14 @@ void ClockModule::begin() {
     // 전역 포인터 설정 (콜백용)
     gClockModulePtr = this;
 
-    // 이벤트 구독
-    gEventBus.subscribe(TIME_SYNCED, onTimeSynced, nullptr);
-    gEventBus.subscribe(SENSOR_UPDATED, onSensorUpdated, nullptr);
-    gEventBus.subscribe(WEATHER_UPDATED, onWeatherUpdated, nullptr);
+    // 이벤트 구독 (이미 발행된 상태는 retained로 바로 받음 - 모듈 초기화 순서와 무관)
+    gEventBus.subscribe(TIME_SYNCED, onTimeSynced, nullptr, true);
+    // 유효하지 않은 측정값과 화면(소수 1자리)에 안 보이는 변화는 Channel에서 걸러냄
+    Channel<SensorData>::subscribe(onSensorUpdated, nullptr, true,
+        Channel<SensorData>::Filter()
+            .whenTrue(&SensorData::valid)
+            .minDelta(&SensorData::temperature, SENSOR_TEMP_DELTA));
+    Channel<WeatherModule::WeatherSummary>::subscribe(onWeatherUpdated, nullptr, true);
 
     _initialized = true;
     _visible = true;
@@ -170,34 +172,26 @@ void ClockModule::onTimeSynced(const Event& event, void* userData) {
     }
 }
 
-// SENSOR_UPDATED 이벤트 콜백
-void ClockModule::onSensorUpdated(const Event& event, void* userData) {
+// SensorData 채널 콜백 (payload 타입과 valid/변화량 필터는 Channel이 보장)
+void ClockModule::onSensorUpdated(const SensorData& data, void* userData) {
     (void)userData;
 
-    if (gClockModulePtr != nullptr && event.data != nullptr) {
-        const SensorData* data = static_cast<const SensorData*>(event.data);
-        if (data != nullptr && data->valid) {
-            gClockModulePtr->_lastSensorTemp = data->temperature;
-            gClockModulePtr->_sensorDataValid = true;
-            gClockModulePtr->_lastUpdate = 0;  // 즉시 갱신 트리거
-            Serial.println(F("ClockModule: Sensor data received"));
-        }
+    if (gClockModulePtr != nullptr) {
+        gClockModulePtr->_lastSensorTemp = data.temperature;
+        gClockModulePtr->_sensorDataValid = true;
+        gClockModulePtr->_lastUpdate = 0;  // 즉시 갱신 트리거
+        Serial.println(F("ClockModule: Sensor data received"));
     }
 }
 
-// WEATHER_UPDATED 이벤트 콜백
-void ClockModule::onWeatherUpdated(const Event& event, void* userData) {
+// WeatherSummary 채널 콜백
+void ClockModule::onWeatherUpdated(const WeatherModule::WeatherSummary& weather, void* userData) {
     (void)userData;
 
-    if (gClockModulePtr != nullptr && event.data != nullptr) {
-        // WeatherModule::WeatherData 구조체 사용
-        const WeatherModule::WeatherData* data =
-            static_cast<const WeatherModule::WeatherData*>(event.data);
-        if (data != nullptr) {
-            gClockModulePtr->_lastWeatherTemp = data->temperature;
-            gClockModulePtr->_weatherDataValid = true;
-            gClockModulePtr->_lastUpdate = 0;  // 즉시 갱신 트리거
-            Serial.println(F("ClockModule: Weather data received"));
-        }
+    if (gClockModulePtr != nullptr) {
+        gClockModulePtr->_lastWeatherTemp = weather.temperature;
+        gClockModulePtr->_weatherDataValid = true;
+        gClockModulePtr->_lastUpdate = 0;  // 즉시 갱신 트리거
+        Serial.println(F("ClockModule: Weather data received"));
     }
 }
@@ -7,6 +7,8 @@
 #include <Arduino.h>
 #include <Adafruit_SSD1306.h>
 #include "../core/event_bus.h"  // Event 타입 사용
+#include "sensor_module.h"         // SensorData 채널
+#include "weather_module.h"        // WeatherSummary 채널
 
 // 전방 선언 (의존성 최소화)
 class TimeManager;
@@ -68,6 +70,7 @@ private:
     bool _weatherDataValid;
 
     static const unsigned long UPDATE_INTERVAL_MS = 1000;  // 1초
+    static constexpr float SENSOR_TEMP_DELTA = 0.1f;       // 화면 온도 표시 단위 (소수 1자리)
 
     /**
      * @brief 시계 화면 그리기
@@ -95,14 +98,14 @@ private:
     static void onTimeSynced(const Event& event, void* userData);
 
     /**
-     * @brief SENSOR_UPDATED 이벤트 콜백 (정적 함수)
+     * @brief SensorData 채널 콜백 (정적 함수)
      */
-    static void onSensorUpdated(const Event& event, void* userData);
+    static void onSensorUpdated(const SensorData& data, void* userData);
 
     /**
-     * @brief WEATHER_UPDATED 이벤트 콜백 (정적 함수)
+     * @brief WeatherSummary 채널 콜백 (정적 함수)
      */
-    static void onWeatherUpdated(const Event& event, void* userData);
+    static void onWeatherUpdated(const WeatherModule::WeatherSummary& weather, void* userData);
 };
 
 // 전역 인스턴스 포인터 (콜백용)
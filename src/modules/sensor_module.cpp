@@ -8,9 +8,7 @@
 #include "../include/arthur_config.h"
 
 // 캐시 키 정의
-const char* const SensorModule::CACHE_KEY_TEMP = "sensor_temp";
-const char* const SensorModule::CACHE_KEY_HUMID = "sensor_humid";
-const char* const SensorModule::CACHE_KEY_PRESS = "sensor_press";
+const char* const SensorModule::CACHE_KEY_DATA = "sensor_data";
 
 // 전역 포인터 정의
 SensorModule* gSensorModulePtr = nullptr;
@@ -122,19 +120,8 @@ bool SensorModule::readSensor(SensorData& outData) {
 }
 
 void SensorModule::cacheSensorData(const SensorData& data) {
-    char buf[16];
-
-    // 온도 캐싱 (TTL: 10분)
-    snprintf(buf, sizeof(buf), "%.1f", data.temperature);
-    CacheMgr.set(CACHE_KEY_TEMP, buf, 600000);
-
-    // 습도 캐싱
-    snprintf(buf, sizeof(buf), "%.0f", data.humidity);
-    CacheMgr.set(CACHE_KEY_HUMID, buf, 600000);
-
-    // 기압 캐싱
-    snprintf(buf, sizeof(buf), "%.0f", data.pressure);
-    CacheMgr.set(CACHE_KEY_PRESS, buf, 600000);
+    // 바이너리 그대로 캐싱 (TTL: 10분) - float 문자열 변환/파싱 없음
+    CacheMgr.setBlob(CACHE_KEY_DATA, data, 600000);
 }
 
 bool SensorModule::isDataValid(const SensorData& data) {
@@ -164,13 +151,8 @@ bool SensorModule::isDataValid(const SensorData& data) {
 }
 
 void SensorModule::publishSensorEvent(const SensorData& data) {
-    // SENSOR_UPDATED 이벤트 발행
-    Event event;
-    event.type = SENSOR_UPDATED;
-    event.timestamp = millis();
-    event.data = &data;  // SensorData 구조체 포인터
-
-    gEventBus.publish(event);
+    // SENSOR_UPDATED 이벤트 발행 (SensorData를 큐에 복사)
+    Channel<SensorData>::publish(data);
 }
 
 void SensorModule::displaySensorData() {
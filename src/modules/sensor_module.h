@@ -10,6 +10,8 @@
 // BME280 라이브러리
 #include <Adafruit_BME280.h>
 
+#include "../core/event_channel.h"
+
 // 전방 선언 (의존성 최소화)
 class TimeManager;
 
@@ -22,13 +24,16 @@ struct SensorData {
     float temperature;    // 온도 (섭씨)
     float humidity;       // 습도 (%)
     float pressure;       // 기압 (hPa)
-    unsigned long timestamp;  // 측정 시각 (millis)
+    uint32_t timestamp;   // 측정 시각 (millis, 이벤트 payload 크기 고정을 위해 32비트)
     bool valid;           // 데이터 유효 여부
 
     // 기본 생성자
     SensorData() : temperature(0), humidity(0), pressure(0), timestamp(0), valid(false) {}
 };
 
+// SENSOR_UPDATED 채널 (구독자: ClockModule + 여유 1)
+EVENT_CHANNEL(SensorData, SENSOR_UPDATED, 2);
+
 /**
  * @brief SensorModule 클래스
  *
@@ -110,9 +115,7 @@ private:
     SensorData _lastData;
 
     // 캐시 키 (정적 상수)
-    static const char* const CACHE_KEY_TEMP;
-    static const char* const CACHE_KEY_HUMID;
-    static const char* const CACHE_KEY_PRESS;
+    static const char* const CACHE_KEY_DATA;   // SensorData 전체 (CacheManager::setBlob)
 
     /**
      * @brief 캐시에 센서 데이터 저장
@@ -1,4 +1,5 @@
 #include "weather_module.h"
+#include "../core/time_manager.h"
 #include <ArduinoJson.h>
 #include <ESP8266WiFi.h>
 
@@ -9,8 +10,12 @@ WeatherModule gWeatherModule;
 // @MX:REASON: 시스템 진입점, begin()에서 설정 로드 및 이벤트 구독
 WeatherModule::WeatherModule()
     : _lastUpdate(0)
+    , _updateInterval(UPDATE_INTERVAL_MS)
     , _wifiConnected(false)
     , _initialized(false)
+    , _cacheLoaded(false)
+    , _stale(false)
+    , _revalidatePending(false)
 {
     _apiKey[0] = '\0';
     _location[0] = '\0';
@@ -23,13 +28,18 @@ bool WeatherModule::begin() {
     // ConfigManager에서 설정 로드
     getApiKey(_apiKey, sizeof(_apiKey));
     getLocation(_location, sizeof(_location));
+    loadUpdateInterval();
 
     // EventBus에 WiFi 이벤트 구독
     gEventBus.subscribe(WIFI_CONNECTED, onWiFiEvent, this);
     gEventBus.subscribe(WIFI_DISCONNECTED, onWiFiEvent, this);
+    gEventBus.subscribe(CONFIG_CHANGED, onConfigChanged, this);
 
-    // 캐시에서 데이터 로드 시도
-    loadFromCache();
+    // stale 캐시를 표시하면 CacheManager가 갱신을 요청
+    CacheMgr.addRevalidateHook("weather_", onCacheStale, this);
+
+    // 캐시에서 데이터 로드 시도 (재부팅 후에도 즉시 표시)
+    _cacheLoaded = loadFromCache();
 
     _initialized = true;
     Serial.println(F("[WeatherModule] Initialized"));
@@ -46,8 +56,21 @@ int WeatherModule::update() {
     // WiFi 연결 상태 확인
     _wifiConnected = (WiFi.status() == WL_CONNECTED);
 
+    // stale 데이터를 표시 중이면 주기와 무관하게 갱신
+    if (_revalidatePending && _wifiConnected) {
+        _revalidatePending = false;
+        if (refresh()) {
+            _lastUpdate = now;
+            return 1;
+        }
+        return 0;
+    }
+
     // 업데이트 주간 도달 시 날씨 새로고침
-    if (_wifiConnected && (now - _lastUpdate >= UPDATE_INTERVAL_MS || _lastUpdate == 0)) {
+    if (_wifiConnected && (now - _lastUpdate >= _updateInterval || _lastUpdate == 0)) {
+        if (_lastUpdate == 0 && !shouldFetchOnBoot(now)) {
+            return 0;
+        }
         if (refresh()) {
             _lastUpdate = now;
             return 1;
@@ -74,13 +97,9 @@ bool WeatherModule::refresh() {
     if (fetchWeatherFromAPI()) {
         // 성공 시 캐시에 저장
         saveToCache();
+        _stale = false;
 
-        // 이벤트 발행
-        Event event;
-        event.type = WEATHER_UPDATED;
-        event.timestamp = millis();
-        event.data = &_currentData;
-        gEventBus.publish(event);
+        publishUpdate();
 
         Serial.print(F("[WeatherModule] Updated: "));
         Serial.print(_currentData.temperature, 1);
@@ -164,9 +183,24 @@ bool WeatherModule::loadFromCache() {
     char cacheKey[64];
     snprintf(cacheKey, sizeof(cacheKey), "weather_%s", _location);
 
-    char jsonBuf[WEATHER_JSON_BUF_SIZE];
-    if (CacheMgr.get(cacheKey, jsonBuf, sizeof(jsonBuf))) {
-        return jsonToWeatherData(jsonBuf);
+    // 세그먼트에서 바로 파싱 (중간 문자열 버퍼 없음)
+    // @MX:NOTE: [stale-while-revalidate] 만료된 데이터도 stale 기간 (24시간) 동안은 표시
+    long ageMs;
+    CacheReader reader;
+    if (CacheMgr.openRead(cacheKey, reader, &ageMs)) {
+        if (!jsonToWeatherData(reader)) {
+            return false;
+        }
+        _stale = (CacheMgr.getTTL(cacheKey) == -1);
+        if (_stale) {
+            Serial.print(F("[WeatherModule] Showing stale data, age "));
+            Serial.print(ageMs < 0 ? -1L : ageMs / 60000);
+            Serial.println(F(" min"));
+        }
+
+        // 캐시 데이터도 발행 - 화면 모듈이 API 호출을 기다리지 않고 바로 표시
+        publishUpdate();
+        return true;
     }
 
     // 캐시 없음 - 빈 데이터 반환
@@ -174,19 +208,72 @@ bool WeatherModule::loadFromCache() {
     return false;
 }
 
-bool WeatherModule::saveToCache() {
+void WeatherModule::publishUpdate() {
+    // 전체 WeatherData는 payload보다 크므로 요약만 복사
+    WeatherSummary summary;
+    summary.temperature = _currentData.temperature;
+    summary.humidity = _currentData.humidity;
+    summary.windSpeed = _currentData.windSpeed;
+    summary.pressure = _currentData.pressure;
+    summary.condition = _currentData.condition;
+    Channel<WeatherSummary>::publish(summary);
+}
+
+long WeatherModule::cachedDataAge() {
     char cacheKey[64];
     snprintf(cacheKey, sizeof(cacheKey), "weather_%s", _location);
 
-    char jsonBuf[WEATHER_JSON_BUF_SIZE];
-    if (weatherDataToJson(jsonBuf, sizeof(jsonBuf))) {
-        return CacheMgr.set(cacheKey, jsonBuf, CACHE_TTL_MS);
+    long ttl = CacheMgr.getTTL(cacheKey);
+    if (ttl < 0 || (unsigned long)ttl > CACHE_TTL_MS) {
+        return -1;  // 없음, 만료, 또는 NTP 동기화 전
+    }
+    return (long)(CACHE_TTL_MS - ttl);
+}
+
+bool WeatherModule::shouldFetchOnBoot(unsigned long now) {
+    if (!_cacheLoaded) {
+        return true;
+    }
+
+    // @MX:NOTE: [웜 리부트] 캐시 만료가 Unix 시각이므로 NTP 동기화 후 실제 나이를 알 수 있음
+    long age = cachedDataAge();
+    if (age < 0) {
+        // 동기화 전이면 잠시 대기, 유예 시간이 지나면 그냥 API 호출
+        return gTimeManager.isSynced() || now >= TIME_SYNC_GRACE_MS;
     }
 
+    if ((unsigned long)age >= _updateInterval) {
+        return true;
+    }
+
+    // 캐시가 충분히 새로움: 남은 주기 후 갱신되도록 마지막 업데이트 시각 역산
+    _lastUpdate = now - (unsigned long)age;
+    if (_lastUpdate == 0) {
+        _lastUpdate = 1;  // 0은 "아직 업데이트 안 됨" 표시
+    }
+    Serial.print(F("[WeatherModule] Cached data is "));
+    Serial.print(age / 1000);
+    Serial.println(F("s old, skipping boot fetch"));
     return false;
 }
 
-bool WeatherModule::weatherDataToJson(char* outBuf, size_t maxLen) {
+bool WeatherModule::saveToCache() {
+    char cacheKey[64];
+    snprintf(cacheKey, sizeof(cacheKey), "weather_%s", _location);
+
+    // 세그먼트에 바로 직렬화 (중간 문자열 버퍼 없음)
+    CacheWriter writer;
+    if (!CacheMgr.openWrite(cacheKey, writer, CACHE_TTL_MS)) {
+        return false;
+    }
+    if (!weatherDataToJson(writer)) {
+        writer.abort();
+        return false;
+    }
+    return writer.commit();
+}
+
+bool WeatherModule::weatherDataToJson(Print& out) {
     StaticJsonDocument<WEATHER_JSON_BUF_SIZE> doc;
 
     doc["temp"] = _currentData.temperature;
@@ -198,13 +285,12 @@ bool WeatherModule::weatherDataToJson(char* outBuf, size_t maxLen) {
     doc["location"] = _currentData.location;
     doc["timestamp"] = _currentData.timestamp;
 
-    size_t len = serializeJson(doc, outBuf, maxLen);
-    return (len > 0 && len < maxLen);
+    return serializeJson(doc, out) > 0;
 }
 
-bool WeatherModule::jsonToWeatherData(const char* jsonStr) {
+bool WeatherModule::jsonToWeatherData(Stream& in) {
     StaticJsonDocument<WEATHER_JSON_BUF_SIZE> doc;
-    DeserializationError error = deserializeJson(doc, jsonStr);
+    DeserializationError error = deserializeJson(doc, in);
 
     if (error) {
         Serial.print(F("[WeatherModule] Cache JSON parse error: "));
@@ -238,24 +324,29 @@ bool WeatherModule::setApiKey(const char* apiKey) {
     strncpy(_apiKey, apiKey, sizeof(_apiKey) - 1);
     _apiKey[sizeof(_apiKey) - 1] = '\0';
 
-    // ConfigManager에 저장
-    return ConfigMgr.set("weather_api_key", apiKey);
+    // ConfigManager에 바로 기록 (사용자 설정이라 드묾, update() 지연 저장에 의존하지 않음)
+    return ConfigMgr.set<Cfg::WeatherApiKey>(apiKey) && ConfigMgr.save();
 }
 
 bool WeatherModule::getApiKey(char* outBuf, size_t maxLen) {
-    return ConfigMgr.get("weather_api_key", outBuf, maxLen, "");
+    return ConfigMgr.get<Cfg::WeatherApiKey>(outBuf, maxLen);
 }
 
 bool WeatherModule::setLocation(const char* location) {
     strncpy(_location, location, sizeof(_location) - 1);
     _location[sizeof(_location) - 1] = '\0';
 
-    // ConfigManager에 저장
-    return ConfigMgr.set("weather_location", location);
+    // ConfigManager에 바로 기록 (사용자 설정이라 드묾, update() 지연 저장에 의존하지 않음)
+    return ConfigMgr.set<Cfg::WeatherLocation>(location) && ConfigMgr.save();
 }
 
 bool WeatherModule::getLocation(char* outBuf, size_t maxLen) {
-    return ConfigMgr.get("weather_location", outBuf, maxLen, "Seoul,KR");
+    return ConfigMgr.get<Cfg::WeatherLocation>(outBuf, maxLen);
+}
+
+void WeatherModule::loadUpdateInterval() {
+    uint32_t interval = ConfigMgr.get<Cfg::WeatherInterval>();
+    _updateInterval = (interval < MIN_UPDATE_INTERVAL_MS) ? MIN_UPDATE_INTERVAL_MS : interval;
 }
 
 const char* WeatherModule::conditionToString(WeatherCondition condition) {
@@ -332,13 +423,37 @@ void WeatherModule::urlEncode(char* dest, const char* src, size_t maxLen) {
     *dest = '\0';
 }
 
+void WeatherModule::onCacheStale(const char* key, void* userData) {
+    (void)key;
+    WeatherModule* module = static_cast<WeatherModule*>(userData);
+    module->_revalidatePending = true;  // WiFi 연결 시 update()에서 갱신
+}
+
+void WeatherModule::onConfigChanged(const Event& event, void* userData) {
+    WeatherModule* module = static_cast<WeatherModule*>(userData);
+    Cfg::Id key = ConfigManager::changedKey(event);
+
+    if (key == Cfg::WEATHER_API_KEY) {
+        module->getApiKey(module->_apiKey, sizeof(module->_apiKey));
+    } else if (key == Cfg::WEATHER_LOCATION) {
+        // 위치가 바뀌면 해당 위치의 캐시를 표시하고 새로 받아옴 (같은 값이면 이벤트 없음)
+        module->getLocation(module->_location, sizeof(module->_location));
+        module->_cacheLoaded = module->loadFromCache();
+        module->_revalidatePending = true;
+    } else if (key == Cfg::WEATHER_INTERVAL) {
+        module->loadUpdateInterval();  // 다음 update()부터 새 주기 적용
+    }
+}
+
 void WeatherModule::onWiFiEvent(const Event& event, void* userData) {
     WeatherModule* module = static_cast<WeatherModule*>(userData);
 
     if (event.type == WIFI_CONNECTED) {
         module->setWiFiConnected(true);
-        // WiFi 연결 시 즉시 날씨 업데이트 시도
-        module->refresh();
+        // 재연결 시 즉시 날씨 업데이트 시도 (부팅 직후는 update()가 캐시 나이로 판단)
+        if (module->_lastUpdate != 0) {
+            module->refresh();
+        }
     } else if (event.type == WIFI_DISCONNECTED) {
         module->setWiFiConnected(false);
     }
@@ -7,6 +7,7 @@
 #include "../core/config_manager.h"
 #include "../core/cache_manager.h"
 #include "../core/event_bus.h"
+#include "../core/event_channel.h"
 
 /**
  * @brief WeatherModule
@@ -18,7 +19,7 @@
  * - 정적 할당만 사용 (new/malloc 금지)
  * - String 클래스 미사용 (char[] + F() 매크로)
  *
- * @MX:NOTE: [오프라인 지원] WiFi 연결 없으면 캐시 데이터 반환
+ * @MX:NOTE: [오프라인 지원] WiFi 연결 없으면 캐시 데이터 반환 (만료 후 24시간까지는 stale로 표시)
  * @MX:ANCHOR: [날씨 인터페이스] UI 및 다른 모듈에서 날씨 정보 조회
  * @MX:REASON: fan_in >= 3 (ClockModule, UIManager 등)
  */
@@ -60,15 +61,27 @@ public:
         }
     };
 
+    // WEATHER_UPDATED 이벤트 payload (WeatherData는 EVENT_PAYLOAD_SIZE보다 커서 수치만 전달)
+    struct WeatherSummary {
+        float temperature;      // 온도 (섭씨)
+        float humidity;         // 습도 (%)
+        float windSpeed;        // 풍속 (m/s)
+        int32_t pressure;       // 기압 (hPa)
+        WeatherCondition condition;  // 날씨 상태
+    };
+
     // 버퍼 크기 상수
     static const size_t API_URL_BUF_SIZE = 256;
     static const size_t WEATHER_JSON_BUF_SIZE = 1024;
     static const size_t LOCATION_BUF_SIZE = 32;
 
-    // 업데이트 간격 (밀리초)
+    // 업데이트 간격 (밀리초) - 기본값, 설정 weather_interval로 변경
     static const unsigned long UPDATE_INTERVAL_MS = 600000;  // 10분
+    static const unsigned long MIN_UPDATE_INTERVAL_MS = 60000;  // API 호출 제한 보호
     // 캐시 TTL (밀리초)
     static const unsigned long CACHE_TTL_MS = 7200000;       // 2시간
+    // 재부팅 직후 캐시 나이 확인을 위해 NTP 동기화를 기다리는 최대 시간
+    static const unsigned long TIME_SYNC_GRACE_MS = 30000;   // 30초
 
     /**
      * @brief 생성자
@@ -97,6 +110,11 @@ public:
      */
     const WeatherData* getWeatherData() const { return &_currentData; }
 
+    /**
+     * @brief 현재 데이터가 만료된 캐시 데이터인지 (UI에서 표시용)
+     */
+    bool isStale() const { return _stale; }
+
     /**
      * @brief 날씨 강제 업데이트
      *
@@ -109,8 +127,8 @@ public:
      * @brief API 키 설정
      *
      * @param apiKey OpenWeatherMap API 키
-     * @return true 설정 성공
-     * @return false 설정 실패
+     * @return true 설정 및 플래시 저장 성공
+     * @return false 설정 또는 저장 실패
      */
     bool setApiKey(const char* apiKey);
 
@@ -128,8 +146,8 @@ public:
      * @brief 위치 설정
      *
      * @param location 도시 이름 (예: "Seoul,KR" 또는 "Tokyo,JP")
-     * @return true 설정 성공
-     * @return false 설정 실패
+     * @return true 설정 및 플래시 저장 성공
+     * @return false 설정 또는 저장 실패
      */
     bool setLocation(const char* location);
 
@@ -172,8 +190,12 @@ private:
 
     WeatherData _currentData;
     unsigned long _lastUpdate;
+    unsigned long _updateInterval;  // Cfg::WeatherInterval (MIN_UPDATE_INTERVAL_MS 이상)
     bool _wifiConnected;
     bool _initialized;
+    bool _cacheLoaded;      // begin()에서 캐시 데이터를 표시했는지
+    bool _stale;            // 현재 데이터가 만료된 캐시 데이터
+    bool _revalidatePending;  // CacheManager 재검증 요청 (WiFi 연결 시 갱신)
 
     char _apiKey[64];
     char _location[LOCATION_BUF_SIZE];
@@ -187,19 +209,40 @@ private:
     // 캐시에 날씨 데이터 저장
     bool saveToCache();
 
-    // 날씨 데이터를 JSON 문자열로 변환
-    bool weatherDataToJson(char* outBuf, size_t maxLen);
+    // 현재 데이터로 WEATHER_UPDATED 발행 (retained로 보관되어 늦은 구독자도 받음)
+    void publishUpdate();
+
+    // 캐시된 날씨의 나이 (밀리초), 알 수 없으면 -1
+    long cachedDataAge();
+
+    // 첫 API 호출 여부 결정 (캐시가 충분히 새로우면 남은 주기만큼 연기)
+    bool shouldFetchOnBoot(unsigned long now);
+
+    // 날씨 데이터를 JSON으로 직렬화 (CacheWriter 등)
+    bool weatherDataToJson(Print& out);
 
-    // JSON 문자열을 날씨 데이터로 파싱
-    bool jsonToWeatherData(const char* jsonStr);
+    // JSON 스트림을 날씨 데이터로 파싱 (CacheReader 등)
+    bool jsonToWeatherData(Stream& in);
 
     // URL 이스케이프 (공백을 %20으로 변환 등)
     void urlEncode(char* dest, const char* src, size_t maxLen);
 
     // 이벤트 버스 콜백 (정적 함수)
     static void onWiFiEvent(const Event& event, void* userData);
+
+    // CacheManager 재검증 훅 (정적 함수)
+    static void onCacheStale(const char* key, void* userData);
+
+    // 설정 변경 콜백 (API 키/위치/갱신 주기를 다시 읽음)
+    static void onConfigChanged(const Event& event, void* userData);
+
+    // 설정에서 갱신 주기 읽기 (최소값 보정)
+    void loadUpdateInterval();
 };
 
+// WEATHER_UPDATED 채널 (구독자: ClockModule + 여유 1)
+EVENT_CHANNEL(WeatherModule::WeatherSummary, WEATHER_UPDATED, 2);
+
 // 전역 인스턴스
 extern WeatherModule gWeatherModule;
 
@@ -12,4 +12,7 @@ unsigned long mock_micros_counter = 0;
 // 전역 Serial 인스턴스
 HardwareSerial Serial;
 
+// 전역 ESP 인스턴스
+EspClass ESP;
+
 #endif // ARTHUR_NATIVE_TEST
@@ -9,6 +9,12 @@
 #include <cstring>
 #include <cstdarg>
 #include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
 
 #ifdef ARTHUR_NATIVE_TEST
 
@@ -54,26 +60,47 @@ inline void mock_reset_millis() {
     mock_micros_counter = 0;
 }
 
-// Serial 클래스 모의
-class HardwareSerial {
+inline void yield() {
+}
+
+// ESP 클래스 모의 (사이클 카운터는 micros 기준 160MHz로 환산)
+class EspClass {
 public:
-    void begin(unsigned long baud) {
-        // 네이티브 환경에서는 baud rate 무시
+    uint32_t getFreeHeap() { return 40000; }
+    uint32_t getCycleCount() { return (uint32_t)(mock_micros_counter * 160); }
+    uint8_t getCpuFreqMHz() { return 160; }
+    void restart() {}
+};
+
+extern EspClass ESP;
+
+// Print 기반 클래스 모의 (Serial, File, CacheWriter 등 출력 스트림 공통)
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t* buf, size_t len) {
+        size_t n = 0;
+        while (n < len && write(buf[n]) == 1) {
+            n++;
+        }
+        return n;
     }
 
-    void end() {
-        // 리소스 정리 (필요시)
+    size_t write(const char* str) {
+        return str ? write((const uint8_t*)str, strlen(str)) : 0;
     }
 
-    // 출력 메서드 (stdout으로 출력)
+    virtual void flush() {}
+
     size_t print(const char* str) {
-        printf("%s", str);
-        return str ? strlen(str) : 0;
+        return str ? write((const uint8_t*)str, strlen(str)) : 0;
     }
 
     size_t print(char c) {
-        putchar(c);
-        return 1;
+        return write((uint8_t)c);
     }
 
     size_t print(unsigned char c, int base = 10) {
@@ -175,27 +202,70 @@ public:
     }
 
     size_t printf(const char* fmt, ...) {
+        char buf[256];
         va_list args;
         va_start(args, fmt);
-        size_t n = vprintf(fmt, args);
+        vsnprintf(buf, sizeof(buf), fmt, args);
         va_end(args);
+        return print(buf);
+    }
+
+};
+
+// Stream 기반 클래스 모의 (입력 스트림 공통)
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    virtual size_t readBytes(char* buf, size_t len) {
+        size_t n = 0;
+        while (n < len) {
+            int c = read();
+            if (c < 0) break;
+            buf[n++] = (char)c;
+        }
         return n;
     }
 
+    size_t readBytes(uint8_t* buf, size_t len) {
+        return readBytes((char*)buf, len);
+    }
+};
+
+// Serial 클래스 모의 (stdout으로 출력)
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) {
+        // 네이티브 환경에서는 baud rate 무시
+    }
+
+    void end() {
+        // 리소스 정리 (필요시)
+    }
+
+    size_t write(uint8_t c) override {
+        putchar(c);
+        return 1;
+    }
+
+    using Print::write;
+
     // 입력 메서드 (테스트용 stub)
-    int available() {
+    int available() override {
         return 0;
     }
 
-    int read() {
+    int read() override {
         return -1;
     }
 
-    int peek() {
+    int peek() override {
         return -1;
     }
 
-    void flush() {
+    void flush() override {
         fflush(stdout);
     }
 };
@@ -311,10 +381,32 @@ private:
 // PROGMEM 매크로 (너이티브에서는 무시)
 #define PROGMEM
 #define FPSTR(string_literal) (string_literal)
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+
+// PROGMEM 읽기 (네이티브에서는 일반 메모리 읽기)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_ptr(addr) (*(const void* const*)(addr))
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define strlen_P strlen
+#define memcpy_P memcpy
+
+// 정수 -> 문자열 (ESP8266 코어 stdlib 확장, glibc에는 없음)
+inline char* itoa(int value, char* str, int base) {
+    if (base == 16) {
+        snprintf(str, 12, "%x", (unsigned)value);
+    } else {
+        snprintf(str, 12, "%d", value);
+    }
+    return str;
+}
 
-// 수학 함수
-#define min(a, b) ((a) < (b) ? (a) : (b))
-#define max(a, b) ((a) > (b) ? (a) : (b))
+// 수학 함수 (min/max는 ESP8266 코어처럼 std 버전 사용 - 매크로면 STL 헤더가 깨짐)
+using std::min;
+using std::max;
 #define abs(x) ((x) > 0 ? (x) : -(x))
 #define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
 #define round(x) ((x) >= 0 ? (long)((x) + 0.5) : (long)((x) - 0.5))
@@ -4,6 +4,10 @@
 
 #ifdef ARTHUR_NATIVE_TEST
 
+MockFileMap mock_fs_files;
+long mock_fs_write_budget = -1;
+bool mock_fs_truncate_fails = false;
+
 FS LittleFS;
 FS SPIFFS;
 
@@ -1,10 +1,12 @@
 // @MX:NOTE: [MOCK] ESP8266 FS.h mock for native testing
+// 파일 내용은 RAM 맵에 보관 - 같은 경로를 다시 열면 이전 내용이 보임 (재부팅 시뮬레이션 가능)
 
 #ifndef ARTHUR_FS_MOCK_H
 #define ARTHUR_FS_MOCK_H
 
 #include <cstdint>
 #include <cstring>
+#include "Arduino.h"
 
 #ifdef ARTHUR_NATIVE_TEST
 
@@ -13,52 +15,129 @@
 #define FILE_WRITE "w"
 #define FILE_APPEND "a"
 
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+struct FSInfo {
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+// 가상 파일 내용 (경로 -> 바이트)
+typedef std::map<std::string, std::vector<uint8_t>> MockFileMap;
+extern MockFileMap mock_fs_files;
+
+// 테스트 헬퍼: 장애 주입
+// mock_fs_write_budget: 남은 기록 가능 바이트 (-1 = 무제한), 0이 되면 이후 기록은 짧게 끝남
+// mock_fs_truncate_fails: truncate() 실패 시뮬레이션
+extern long mock_fs_write_budget;
+extern bool mock_fs_truncate_fails;
+
+inline void mock_fs_reset() {
+    mock_fs_files.clear();
+    mock_fs_write_budget = -1;
+    mock_fs_truncate_fails = false;
+}
+
 // 가상 파일 클래스
-class File {
+class File : public Stream {
 public:
-    File() : _isOpen(false), _position(0), _size(0) {}
-    ~File() {}
+    File() : _writable(false), _append(false), _position(0) {}
+
+    File(const std::string& path, bool writable, bool append)
+        : _path(std::make_shared<std::string>(path))
+        , _writable(writable)
+        , _append(append)
+        , _position(0)
+    {
+    }
 
-    operator bool() const {
-        return _isOpen;
+    explicit operator bool() const {
+        return (bool)_path;
     }
 
     size_t read(uint8_t* buf, size_t len) {
-        if (!_isOpen) return 0;
-        size_t toRead = (len > (_size - _position)) ? (_size - _position) : len;
+        if (!_path) return 0;
+        std::vector<uint8_t>& data = content();
+        if (_position >= data.size()) return 0;
+        size_t toRead = (len > (data.size() - _position)) ? (data.size() - _position) : len;
+        memcpy(buf, data.data() + _position, toRead);
         _position += toRead;
         return toRead;
     }
 
-    size_t write(const uint8_t* buf, size_t len) {
-        if (!_isOpen) return 0;
+    size_t write(const uint8_t* buf, size_t len) override {
+        if (!_path || !_writable) return 0;
+        if (mock_fs_write_budget >= 0 && (long)len > mock_fs_write_budget) {
+            len = mock_fs_write_budget;
+        }
+        if (mock_fs_write_budget >= 0) {
+            mock_fs_write_budget -= len;
+        }
+
+        std::vector<uint8_t>& data = content();
+        if (_append) {
+            _position = data.size();
+        }
+        if (data.size() < _position + len) {
+            data.resize(_position + len);
+        }
+        if (len > 0) {
+            memcpy(data.data() + _position, buf, len);
+        }
         _position += len;
-        if (_position > _size) _size = _position;
         return len;
     }
 
-    int read() {
-        if (!_isOpen || _position >= _size) return -1;
-        return 0;  // Mock: return 0
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+
+    using Print::write;
+
+    int read() override {
+        uint8_t c;
+        return read(&c, 1) == 1 ? c : -1;
     }
 
-    size_t write(uint8_t c) {
-        return write(&c, 1);
+    int peek() override {
+        if (!_path) return -1;
+        std::vector<uint8_t>& data = content();
+        return _position < data.size() ? data[_position] : -1;
     }
 
-    int peek() {
-        if (!_isOpen || _position >= _size) return -1;
-        return 0;  // Mock: return 0
+    int available() override {
+        if (!_path) return 0;
+        return (int)(content().size() - _position);
     }
 
-    void flush() {
+    size_t readBytes(char* buf, size_t len) override {
+        return read((uint8_t*)buf, len);
+    }
+
+    void flush() override {
         // Stub
     }
 
-    bool seek(uint32_t pos) {
-        if (!_isOpen) return false;
-        if (pos > _size) return false;
-        _position = pos;
+    bool seek(uint32_t pos, SeekMode mode = SeekSet) {
+        if (!_path) return false;
+        size_t base = (mode == SeekSet) ? 0 : (mode == SeekCur) ? _position : content().size();
+        if (base + pos > content().size()) return false;
+        _position = base + pos;
+        return true;
+    }
+
+    bool truncate(uint32_t size) {
+        if (!_path || !_writable || mock_fs_truncate_fails) return false;
+        content().resize(size);
+        if (_position > size) _position = size;
         return true;
     }
 
@@ -66,38 +145,70 @@ public:
         return _position;
     }
 
-    uint32_t size() const {
-        return _size;
+    uint32_t size() {
+        return _path ? content().size() : 0;
     }
 
     void close() {
-        _isOpen = false;
+        _path.reset();
     }
 
     const char* name() const {
-        return "mock_file";
+        return _path ? _path->c_str() : "";
     }
 
     bool isDirectory() const {
         return false;
     }
 
-    File openNextFile(const char* mode = FILE_READ) {
-        return File();
+private:
+    std::shared_ptr<std::string> _path;
+    bool _writable;
+    bool _append;
+    size_t _position;
+
+    std::vector<uint8_t>& content() {
+        return mock_fs_files[*_path];
     }
+};
 
-    void rewindDirectory() {
-        // Stub
+// 디렉토리 순회 (바로 아래 파일만, 경로 순)
+class Dir {
+public:
+    explicit Dir(const std::string& path) : _prefix(path + "/"), _started(false) {}
+
+    bool next() {
+        MockFileMap::iterator it = _started ? mock_fs_files.upper_bound(_current)
+                                            : mock_fs_files.lower_bound(_prefix);
+        _started = true;
+        for (; it != mock_fs_files.end(); ++it) {
+            if (it->first.compare(0, _prefix.size(), _prefix) != 0) {
+                break;
+            }
+            if (it->first.find('/', _prefix.size()) == std::string::npos) {
+                _current = it->first;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    String fileName() {
+        return String(_current.c_str() + _prefix.size());
     }
 
-    // Mock control
-    void setOpen(bool open) { _isOpen = open; }
-    void setSize(uint32_t size) { _size = size; }
+    size_t fileSize() {
+        return mock_fs_files[_current].size();
+    }
+
+    File openFile(const char* mode) {
+        return File(_current, mode[0] != 'r' || mode[1] == '+', mode[0] == 'a');
+    }
 
 private:
-    bool _isOpen;
-    uint32_t _position;
-    uint32_t _size;
+    std::string _prefix;
+    std::string _current;
+    bool _started;
 };
 
 // 가상 파일 시스템 클래스
@@ -115,13 +226,22 @@ public:
     }
 
     bool format() {
+        mock_fs_files.clear();
         return true;
     }
 
     File open(const char* path, const char* mode = FILE_READ) {
-        File f;
-        f.setOpen(true);
-        return f;
+        std::string key(path);
+        bool exists = mock_fs_files.count(key) > 0;
+        if (mode[0] == 'r' && !exists) {
+            return File();
+        }
+        if (mode[0] == 'w') {
+            mock_fs_files[key].clear();
+        } else if (mode[0] == 'a') {
+            mock_fs_files[key];
+        }
+        return File(key, mode[0] != 'r' || mode[1] == '+', mode[0] == 'a');
     }
 
     File open(const String& path, const char* mode = FILE_READ) {
@@ -129,7 +249,13 @@ public:
     }
 
     bool exists(const char* path) {
-        return false;  // Mock: file doesn't exist
+        std::string key(path);
+        if (mock_fs_files.count(key) > 0) {
+            return true;
+        }
+        // 디렉토리: 그 아래 파일이 있으면 존재
+        MockFileMap::iterator it = mock_fs_files.lower_bound(key + "/");
+        return it != mock_fs_files.end() && it->first.compare(0, key.size() + 1, key + "/") == 0;
     }
 
     bool exists(const String& path) {
@@ -137,7 +263,7 @@ public:
     }
 
     bool remove(const char* path) {
-        return true;
+        return mock_fs_files.erase(path) > 0;
     }
 
     bool remove(const String& path) {
@@ -145,6 +271,13 @@ public:
     }
 
     bool rename(const char* pathFrom, const char* pathTo) {
+        MockFileMap::iterator it = mock_fs_files.find(pathFrom);
+        if (it == mock_fs_files.end()) {
+            return false;
+        }
+        std::vector<uint8_t> data = it->second;
+        mock_fs_files.erase(it);
+        mock_fs_files[pathTo] = data;
         return true;
     }
 
@@ -160,12 +293,31 @@ public:
         return true;
     }
 
+    Dir openDir(const char* path) {
+        return Dir(path);
+    }
+
+    bool info(FSInfo& info) {
+        memset(&info, 0, sizeof(info));
+        info.totalBytes = totalBytes();
+        info.usedBytes = usedBytes();
+        info.blockSize = blockSize();
+        info.pageSize = 256;
+        info.maxOpenFiles = 5;
+        info.maxPathLength = 32;
+        return true;
+    }
+
     uint32_t totalBytes() {
         return 1024 * 1024;  // 1MB mock
     }
 
     uint32_t usedBytes() {
-        return 0;
+        uint32_t used = 0;
+        for (MockFileMap::iterator it = mock_fs_files.begin(); it != mock_fs_files.end(); ++it) {
+            used += it->second.size();
+        }
+        return used;
     }
 
     uint32_t blockSize() {
@@ -0,0 +1,363 @@
+// @MX:NOTE: [TEST] CacheManager 세그먼트 로그 테스트 (RAM 파일시스템 mock 사용)
+// 재부팅은 새 CacheManager 인스턴스의 begin()으로 시뮬레이션 (파일 내용은 유지)
+// 실행: pio test -e native_test -f test_cache_manager -v
+
+#ifdef ARTHUR_NATIVE_TEST
+
+#include <unity.h>
+#include "Arduino.h"
+#include "FS.h"
+#include "../../src/core/cache_manager.cpp"
+
+// TimeManager 대체 (NTP 없이 동기화 상태를 테스트에서 제어)
+static bool mockTimeSynced = false;
+static unsigned long mockUnixTime = 0;
+
+TimeManager::TimeManager() {}
+bool TimeManager::isSynced() { return mockTimeSynced; }
+unsigned long TimeManager::getTimestamp() { return mockUnixTime; }
+TimeManager gTimeManager;
+
+static size_t segmentFileSize() {
+    return mock_fs_files[LITTLEFS_CACHE_SEGMENT_FILE].size();
+}
+
+void setUp(void) {
+    mock_fs_reset();
+    mock_reset_millis();
+    mockTimeSynced = false;
+    mockUnixTime = 0;
+}
+
+void tearDown(void) {}
+
+void test_cache_rebuild_after_reboot(void) {
+    char buf[32];
+    {
+        CacheManager cache;
+        TEST_ASSERT_TRUE(cache.begin());
+        TEST_ASSERT_TRUE(cache.set("a", "first", 60000));
+        TEST_ASSERT_TRUE(cache.set("b", "keep", 60000));
+        TEST_ASSERT_TRUE(cache.set("a", "second", 60000));
+        TEST_ASSERT_TRUE(cache.set("c", "gone", 60000));
+        TEST_ASSERT_TRUE(cache.remove("c"));
+        TEST_ASSERT_TRUE(cache.flush() >= 0);
+        TEST_ASSERT_EQUAL(0, cache.dirtyCount());
+    }
+
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(2, rebooted.count());
+    TEST_ASSERT_TRUE(rebooted.get("a", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("second", buf);
+    TEST_ASSERT_TRUE(rebooted.get("b", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("keep", buf);
+    TEST_ASSERT_FALSE(rebooted.has("c"));  // tombstone
+    TEST_ASSERT_EQUAL(segmentFileSize(), rebooted.segmentSize());
+}
+
+void test_cache_rebuild_drops_torn_tail(void) {
+    {
+        CacheManager cache;
+        TEST_ASSERT_TRUE(cache.begin());
+        TEST_ASSERT_TRUE(cache.set("a", "value", 60000));
+        TEST_ASSERT_TRUE(cache.flush() >= 0);
+    }
+    size_t intact = segmentFileSize();
+
+    // 헤더 중간에서 전원이 꺼진 레코드
+    mock_fs_files[LITTLEFS_CACHE_SEGMENT_FILE].push_back(0xA5);
+    mock_fs_files[LITTLEFS_CACHE_SEGMENT_FILE].push_back(0x00);
+
+    char buf[32];
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_TRUE(rebooted.get("a", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("value", buf);
+    TEST_ASSERT_EQUAL(intact, segmentFileSize());
+    TEST_ASSERT_EQUAL(intact, rebooted.segmentSize());
+}
+
+void test_cache_compaction(void) {
+    char value[16];
+    char buf[32];
+    {
+        CacheManager cache;
+        TEST_ASSERT_TRUE(cache.begin());
+        cache.setWriteBehind(false);
+
+        // 같은 두 키를 반복 덮어쓰면 무효 바이트가 쌓여 컴팩션됨
+        for (int i = 0; i < 2000; i++) {
+            snprintf(value, sizeof(value), "%d", i);
+            TEST_ASSERT_TRUE(cache.set("temp", value, 60000));
+            TEST_ASSERT_TRUE(cache.set("humid", value, 60000));
+        }
+        TEST_ASSERT_TRUE(cache.segmentSize() <= LITTLEFS_CACHE_COMPACT_THRESHOLD + 64);
+        TEST_ASSERT_EQUAL(segmentFileSize(), cache.segmentSize());
+        TEST_ASSERT_FALSE(LittleFS.exists(LITTLEFS_CACHE_COMPACT_FILE));
+
+        // 명시적 컴팩션은 살아있는 레코드만 남김
+        TEST_ASSERT_TRUE(cache.compact());
+        TEST_ASSERT_EQUAL(4 + cache.bytesUsed(), cache.segmentSize());
+    }
+
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(2, rebooted.count());
+    TEST_ASSERT_TRUE(rebooted.get("temp", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("1999", buf);
+    TEST_ASSERT_TRUE(rebooted.get("humid", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("1999", buf);
+}
+
+void test_cache_short_write_rolled_back(void) {
+    char buf[32];
+    {
+        CacheManager cache;
+        TEST_ASSERT_TRUE(cache.begin());
+        cache.setWriteBehind(false);
+        TEST_ASSERT_TRUE(cache.set("a", "first", 60000));
+
+        // 헤더 일부만 기록되고 실패 - 레코드 시작 위치로 되돌아가야 함
+        size_t before = cache.segmentSize();
+        mock_fs_write_budget = 5;
+        TEST_ASSERT_FALSE(cache.set("b", "torn", 60000));
+        mock_fs_write_budget = -1;
+        TEST_ASSERT_EQUAL(before, cache.segmentSize());
+        TEST_ASSERT_EQUAL(before, segmentFileSize());
+
+        TEST_ASSERT_TRUE(cache.set("c", "after", 60000));
+    }
+
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(2, rebooted.count());
+    TEST_ASSERT_TRUE(rebooted.get("a", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("first", buf);
+    TEST_ASSERT_TRUE(rebooted.get("c", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("after", buf);
+}
+
+void test_cache_short_write_compacts_when_truncate_fails(void) {
+    char buf[32];
+    {
+        CacheManager cache;
+        TEST_ASSERT_TRUE(cache.begin());
+        cache.setWriteBehind(true);
+        TEST_ASSERT_TRUE(cache.set("a", "dirty", 60000));
+
+        // flush 중 짧은 쓰기 + truncate 실패 - 컴팩션으로 부분 기록 제거
+        mock_fs_write_budget = 3;
+        mock_fs_truncate_fails = true;
+        TEST_ASSERT_EQUAL(-1, cache.flush());
+        mock_fs_write_budget = -1;
+        mock_fs_truncate_fails = false;
+        TEST_ASSERT_EQUAL(cache.segmentSize(), segmentFileSize());
+        TEST_ASSERT_EQUAL(1, cache.dirtyCount());  // 값은 RAM에 남아 재시도
+
+        TEST_ASSERT_EQUAL(1, cache.flush());
+        TEST_ASSERT_TRUE(cache.set("b", "later", 60000));
+        TEST_ASSERT_TRUE(cache.flush() >= 0);
+    }
+
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(2, rebooted.count());
+    TEST_ASSERT_TRUE(rebooted.get("a", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("dirty", buf);
+    TEST_ASSERT_TRUE(rebooted.get("b", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("later", buf);
+}
+
+void test_cache_failed_write_through_keeps_dirty_value(void) {
+    char buf[96];
+    char big[80];
+    memset(big, 'x', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+
+    CacheManager cache;
+    TEST_ASSERT_TRUE(cache.begin());
+    cache.setWriteBehind(true);
+    TEST_ASSERT_TRUE(cache.set("k", "dirty", 60000));
+    TEST_ASSERT_EQUAL(1, cache.dirtyCount());
+
+    // hot 슬롯보다 큰 값은 write-through - 기록 실패 시 이전 dirty 값 유지
+    mock_fs_write_budget = 0;
+    TEST_ASSERT_FALSE(cache.set("k", big, 60000));
+    mock_fs_write_budget = -1;
+    TEST_ASSERT_EQUAL(1, cache.dirtyCount());
+    TEST_ASSERT_TRUE(cache.get("k", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("dirty", buf);
+
+    TEST_ASSERT_EQUAL(1, cache.flush());
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_TRUE(rebooted.get("k", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("dirty", buf);
+}
+
+void test_cache_failed_write_through_keeps_index(void) {
+    char key[8];
+    char buf[32];
+
+    CacheManager cache;
+    TEST_ASSERT_TRUE(cache.begin());
+    cache.setWriteBehind(false);
+    TEST_ASSERT_TRUE(cache.set("base", "old", 60000));
+
+    // 모든 hot 슬롯을 dirty로 채운 뒤 flush와 write-through가 모두 실패하는 상황
+    cache.setWriteBehind(true, 60000, 200);
+    mock_fs_write_budget = 0;
+    for (int i = 0; i < 64; i++) {
+        snprintf(key, sizeof(key), "d%d", i);
+        if (!cache.set(key, "v", 60000)) {
+            break;
+        }
+    }
+    TEST_ASSERT_FALSE(cache.set("base", "new", 60000));
+    mock_fs_write_budget = -1;
+
+    TEST_ASSERT_TRUE(cache.get("base", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("old", buf);
+}
+
+void test_cache_expiry_queries_report_ttl_not_removal(void) {
+    CacheManager cache;
+    TEST_ASSERT_TRUE(cache.begin());
+    cache.setWriteBehind(false);  // update()가 flush 대신 sweep을 실행하도록
+    cache.setStaleWindow(60000);
+    TEST_ASSERT_TRUE(cache.set("short", "1", 1000));
+    TEST_ASSERT_TRUE(cache.set("long", "2", 10000));
+
+    TEST_ASSERT_EQUAL(1000, cache.nextExpiryIn());
+    TEST_ASSERT_EQUAL(61000, cache.nextRemovalIn());
+    TEST_ASSERT_EQUAL(1, cache.countExpiringWithin(5000));
+    TEST_ASSERT_EQUAL(2, cache.countExpiringWithin(10000));
+
+    // 만료 후 stale 기간: 만료 질의는 도래, 삭제는 아직
+    mock_advance_millis(2000);
+    TEST_ASSERT_EQUAL(0, cache.nextExpiryIn());
+    TEST_ASSERT_EQUAL(59000, cache.nextRemovalIn());
+    TEST_ASSERT_EQUAL(1, cache.countExpiringWithin(0));
+    cache.update();
+    TEST_ASSERT_EQUAL(2, cache.count());
+
+    mock_advance_millis(60000);
+    TEST_ASSERT_EQUAL(0, cache.nextRemovalIn());
+    cache.update();
+    TEST_ASSERT_EQUAL(1, cache.count());
+}
+
+void test_cache_hash_collision_keeps_other_key(void) {
+    // FNV-1a 32비트 해시가 같은 서로 다른 키 (둘 다 0x92C402BE)
+    const char* keyA = "k32728";
+    const char* keyB = "k261234";
+
+    char buf[32];
+    {
+        CacheManager cache;
+        TEST_ASSERT_TRUE(cache.begin());
+        TEST_ASSERT_TRUE(cache.set(keyA, "alpha", 60000));   // hot 슬롯에도 올라감
+
+        TEST_ASSERT_FALSE(cache.has(keyB));
+        TEST_ASSERT_EQUAL(-1, cache.getTTL(keyB));
+        TEST_ASSERT_FALSE(cache.get(keyB, buf, sizeof(buf)));
+        TEST_ASSERT_FALSE(cache.set(keyB, "beta", 60000));   // 덮어쓰지 않고 거부
+        TEST_ASSERT_TRUE(cache.remove(keyB));                // 없는 키 - keyA는 그대로
+
+        TEST_ASSERT_TRUE(cache.get(keyA, buf, sizeof(buf)));
+        TEST_ASSERT_EQUAL_STRING("alpha", buf);
+        TEST_ASSERT_TRUE(cache.flush() >= 0);
+    }
+
+    // 재부팅 후에는 hot 슬롯이 없으므로 세그먼트 레코드의 키와 비교
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_FALSE(rebooted.has(keyB));
+    TEST_ASSERT_TRUE(rebooted.remove(keyB));
+    CacheWriter writer;
+    TEST_ASSERT_FALSE(rebooted.openWrite(keyB, writer, 60000));
+    TEST_ASSERT_TRUE(rebooted.has(keyA));
+    TEST_ASSERT_TRUE(rebooted.get(keyA, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("alpha", buf);
+}
+
+void test_cache_write_behind_interval_flush_single_key(void) {
+    char buf[32];
+    {
+        CacheManager cache;
+        TEST_ASSERT_TRUE(cache.begin());
+        cache.setWriteBehind(true, 60000);
+
+        // 키 하나만 반복 갱신 - dirty 수가 maxDirty에 닿지 않으므로 주기 flush만 기록함
+        TEST_ASSERT_TRUE(cache.set("sensor_data", "1", 600000));
+        mock_advance_millis(30000);
+        TEST_ASSERT_TRUE(cache.set("sensor_data", "2", 600000));
+        cache.update();
+        TEST_ASSERT_EQUAL(1, cache.dirtyCount());
+
+        // 첫 dirty 기준 60초 경과
+        mock_advance_millis(30000);
+        cache.update();
+        TEST_ASSERT_EQUAL(0, cache.dirtyCount());
+    }
+
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_TRUE(rebooted.get("sensor_data", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("2", buf);
+}
+
+void test_cache_stream_write_reserves_index_before_writing(void) {
+    char buf[32];
+    {
+        CacheManager cache;
+        TEST_ASSERT_TRUE(cache.begin());
+        cache.setQuota(LITTLEFS_CACHE_QUOTA_BYTES, 2);
+        TEST_ASSERT_TRUE(cache.set("a", "1", 60000));
+        TEST_ASSERT_TRUE(cache.set("b", "2", 60000));
+
+        // 인덱스가 가득 찬 상태 - openWrite()가 기록 전에 "a"를 evict (tombstone 포함)
+        CacheWriter writer;
+        TEST_ASSERT_TRUE(cache.openWrite("c", writer, 60000));
+        TEST_ASSERT_FALSE(cache.has("a"));
+        writer.print("streamed");
+
+        // 스트리밍 중의 set()은 tombstone 없이 다른 항목을 evict하지 않고 실패
+        TEST_ASSERT_FALSE(cache.set("d", "4", 60000));
+        TEST_ASSERT_TRUE(cache.has("b"));
+
+        TEST_ASSERT_TRUE(writer.commit());
+        TEST_ASSERT_EQUAL(2, cache.count());
+    }
+
+    // 재부팅 후에도 evict된 항목이 되살아나지 않음
+    CacheManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(2, rebooted.count());
+    TEST_ASSERT_FALSE(rebooted.has("a"));
+    TEST_ASSERT_TRUE(rebooted.has("b"));
+    TEST_ASSERT_FALSE(rebooted.has("d"));
+    TEST_ASSERT_TRUE(rebooted.get("c", buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("streamed", buf);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_cache_rebuild_after_reboot);
+    RUN_TEST(test_cache_rebuild_drops_torn_tail);
+    RUN_TEST(test_cache_compaction);
+    RUN_TEST(test_cache_short_write_rolled_back);
+    RUN_TEST(test_cache_short_write_compacts_when_truncate_fails);
+    RUN_TEST(test_cache_failed_write_through_keeps_dirty_value);
+    RUN_TEST(test_cache_failed_write_through_keeps_index);
+    RUN_TEST(test_cache_expiry_queries_report_ttl_not_removal);
+    RUN_TEST(test_cache_hash_collision_keeps_other_key);
+    RUN_TEST(test_cache_write_behind_interval_flush_single_key);
+    RUN_TEST(test_cache_stream_write_reserves_index_before_writing);
+
+    return UNITY_END();
+}
+
+#endif // ARTHUR_NATIVE_TEST
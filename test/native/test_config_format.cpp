@@ -0,0 +1,99 @@
+// @MX:NOTE: [BENCH] 설정 저장 형식 비교 (JSON vs MessagePack)
+// ConfigManager가 플래시에 쓰는 문서와 같은 형태로 파싱 시간과 크기를 측정
+// 실행: pio test -e native_test -f test_config_format -v
+
+#ifdef ARTHUR_NATIVE_TEST
+
+#include <unity.h>
+#include <ArduinoJson.h>
+#include <chrono>
+#include <cstdio>
+
+// ConfigManager::JSON_DOC_SIZE와 동일
+static const size_t DOC_SIZE = 1024;
+static const int ITERATIONS = 2000;
+
+static uint8_t jsonBuf[DOC_SIZE];
+static uint8_t msgpackBuf[DOC_SIZE];
+static size_t jsonLen = 0;
+static size_t msgpackLen = 0;
+
+// 실제 장치 설정과 비슷한 구성 (문자열 + 정수 + 불리언)
+static void buildSampleConfig(JsonDocument& doc) {
+    doc["weather_api_key"] = "0123456789abcdef0123456789abcdef";
+    doc["weather_location"] = "Seoul,KR";
+    doc["weather_interval"] = 600000;
+    doc["ntp_server"] = "pool.ntp.org";
+    doc["tz_offset"] = 9;
+    doc["display_brightness"] = 128;
+    doc["display_flip"] = false;
+    doc["sensor_interval"] = 5000;
+    doc["mqtt_host"] = "192.168.0.10";
+    doc["mqtt_port"] = 1883;
+    doc["mqtt_enabled"] = true;
+    doc["device_name"] = "arthur-livingroom";
+}
+
+template <typename TParse>
+static double measureMicros(TParse parse) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        parse();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / ITERATIONS;
+}
+
+void setUp(void) {
+    StaticJsonDocument<DOC_SIZE> doc;
+    buildSampleConfig(doc);
+    jsonLen = serializeJson(doc, (char*)jsonBuf, sizeof(jsonBuf));
+    msgpackLen = serializeMsgPack(doc, msgpackBuf, sizeof(msgpackBuf));
+}
+
+void tearDown(void) {}
+
+void test_config_format_roundtrip(void) {
+    StaticJsonDocument<DOC_SIZE> doc;
+
+    TEST_ASSERT_FALSE(deserializeMsgPack(doc, msgpackBuf, msgpackLen));
+    TEST_ASSERT_EQUAL_STRING("Seoul,KR", doc["weather_location"].as<const char*>());
+    TEST_ASSERT_EQUAL(600000, doc["weather_interval"].as<long>());
+    TEST_ASSERT_TRUE(doc["mqtt_enabled"].as<bool>());
+}
+
+void test_config_format_size(void) {
+    printf("[bench] size: json=%u msgpack=%u bytes\n",
+           (unsigned)jsonLen, (unsigned)msgpackLen);
+    TEST_ASSERT_TRUE(jsonLen > 0);
+    TEST_ASSERT_TRUE(msgpackLen > 0);
+    TEST_ASSERT_TRUE(msgpackLen < jsonLen);
+}
+
+void test_config_format_parse_time(void) {
+    StaticJsonDocument<DOC_SIZE> doc;
+
+    double jsonUs = measureMicros([&]() {
+        deserializeJson(doc, (const char*)jsonBuf, jsonLen);
+    });
+    double msgpackUs = measureMicros([&]() {
+        deserializeMsgPack(doc, msgpackBuf, msgpackLen);
+    });
+
+    // 호스트 측정값 - 절대값보다 비율을 참고 (ESP8266에서는 플래시 읽기 시간이 추가됨)
+    printf("[bench] parse: json=%.2f us msgpack=%.2f us (x%.2f)\n",
+           jsonUs, msgpackUs, jsonUs / msgpackUs);
+    TEST_ASSERT_TRUE(msgpackUs > 0.0);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_config_format_roundtrip);
+    RUN_TEST(test_config_format_size);
+    RUN_TEST(test_config_format_parse_time);
+
+    return UNITY_END();
+}
+
+#endif // ARTHUR_NATIVE_TEST
@@ -0,0 +1,322 @@
+// @MX:NOTE: [TEST] ConfigManager A/B 슬롯 + 트랜잭션 테스트 (RAM 파일시스템 mock 사용)
+// 재부팅은 새 ConfigManager 인스턴스의 begin()으로 시뮬레이션 (파일 내용은 유지)
+// 실행: pio test -e native_test -f test_config_manager -v
+
+#ifdef ARTHUR_NATIVE_TEST
+
+#include <unity.h>
+#include "Arduino.h"
+#include "FS.h"
+#include "../../src/core/event_bus.cpp"
+#include "../../src/core/config_manager.cpp"
+
+static int configChangedCount = 0;
+
+static void onConfigChanged(const Event& event, void* userData) {
+    configChangedCount++;
+}
+
+// exportJson() 출력 캡처
+class StringPrint : public Print {
+public:
+    std::string text;
+    size_t write(uint8_t c) override { text += (char)c; return 1; }
+    using Print::write;
+};
+
+// 슬롯 헤더의 CRC 변조 (payload는 파싱 가능 - CRC 확인만으로 걸러져야 함)
+static void corruptSlotCrc(const char* path) {
+    std::vector<uint8_t>& data = mock_fs_files[path];
+    TEST_ASSERT_TRUE(data.size() > 16);
+    data[12] ^= 0xFF;  // SlotHeader::crc
+}
+
+void setUp(void) {
+    mock_fs_reset();
+    mock_reset_millis();
+    gEventBus.clear();
+    gEventBus.begin();
+    gEventBus.subscribe(CONFIG_CHANGED, onConfigChanged);
+    configChangedCount = 0;
+}
+
+void tearDown(void) {}
+
+void test_config_reload_after_reboot(void) {
+    char buf[32];
+    {
+        ConfigManager config;
+        TEST_ASSERT_TRUE(config.begin());
+        TEST_ASSERT_TRUE(config.set("name", "arthur"));
+        TEST_ASSERT_TRUE(config.setInt("interval", 600));
+        TEST_ASSERT_TRUE(config.setBool("flip", true));
+        TEST_ASSERT_TRUE(config.save());
+        TEST_ASSERT_FALSE(config.isDirty());
+    }
+
+    ConfigManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_TRUE(rebooted.get("name", buf, sizeof(buf), ""));
+    TEST_ASSERT_EQUAL_STRING("arthur", buf);
+    TEST_ASSERT_EQUAL(600, rebooted.getInt("interval", 0));
+    TEST_ASSERT_TRUE(rebooted.getBool("flip", false));
+}
+
+void test_config_save_alternates_slots(void) {
+    ConfigManager config;
+    TEST_ASSERT_TRUE(config.begin());
+    TEST_ASSERT_TRUE(config.setInt("interval", 1));
+    TEST_ASSERT_TRUE(config.save());
+    TEST_ASSERT_TRUE(mock_fs_files.count(LITTLEFS_CONFIG_SLOT_A_FILE) > 0);
+    TEST_ASSERT_TRUE(mock_fs_files.count(LITTLEFS_CONFIG_SLOT_B_FILE) == 0);
+
+    TEST_ASSERT_TRUE(config.setInt("interval", 2));
+    TEST_ASSERT_TRUE(config.save());
+    TEST_ASSERT_TRUE(mock_fs_files.count(LITTLEFS_CONFIG_SLOT_B_FILE) > 0);
+
+    // 세대가 높은 B가 최신
+    ConfigManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(2, rebooted.getInt("interval", 0));
+}
+
+void test_config_crc_failure_falls_back(void) {
+    {
+        ConfigManager config;
+        TEST_ASSERT_TRUE(config.begin());
+        TEST_ASSERT_TRUE(config.setInt("interval", 1));
+        TEST_ASSERT_TRUE(config.save());  // A (세대 1)
+        TEST_ASSERT_TRUE(config.setInt("interval", 2));
+        TEST_ASSERT_TRUE(config.save());  // B (세대 2)
+    }
+    corruptSlotCrc(LITTLEFS_CONFIG_SLOT_B_FILE);
+
+    ConfigManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(1, rebooted.getInt("interval", 0));
+
+    // 다음 저장은 유효한 A가 아닌 B를 덮어씀
+    TEST_ASSERT_TRUE(rebooted.setInt("interval", 3));
+    TEST_ASSERT_TRUE(rebooted.save());
+    ConfigManager again;
+    TEST_ASSERT_TRUE(again.begin());
+    TEST_ASSERT_EQUAL(3, again.getInt("interval", 0));
+}
+
+void test_config_torn_save_keeps_previous_slot(void) {
+    {
+        ConfigManager config;
+        TEST_ASSERT_TRUE(config.begin());
+        TEST_ASSERT_TRUE(config.setInt("interval", 1));
+        TEST_ASSERT_TRUE(config.save());  // A
+
+        // payload 중간에서 전원 차단 - 헤더(magic)는 기록되지 않음
+        mock_fs_write_budget = 20;
+        TEST_ASSERT_TRUE(config.setInt("interval", 2));
+        TEST_ASSERT_FALSE(config.save());
+        TEST_ASSERT_TRUE(config.isDirty());
+    }
+    mock_fs_write_budget = -1;
+
+    ConfigManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(1, rebooted.getInt("interval", 0));
+}
+
+void test_config_rollback_restores_values(void) {
+    char buf[32];
+    ConfigManager config;
+    TEST_ASSERT_TRUE(config.begin());
+    TEST_ASSERT_TRUE(config.set("name", "before"));
+    TEST_ASSERT_TRUE(config.setInt("interval", 1));
+
+    // 대기 중인 변경은 시작 시 저장되어 롤백 기준점이 됨
+    TEST_ASSERT_TRUE(config.beginTransaction());
+    TEST_ASSERT_FALSE(config.isDirty());
+    TEST_ASSERT_FALSE(config.beginTransaction());
+
+    TEST_ASSERT_TRUE(config.set("name", "during"));
+    TEST_ASSERT_TRUE(config.setInt("interval", 2));
+    TEST_ASSERT_TRUE(config.setBool("extra", true));
+    TEST_ASSERT_TRUE(config.rollback());
+    TEST_ASSERT_FALSE(config.inTransaction());
+    TEST_ASSERT_FALSE(config.rollback());
+
+    TEST_ASSERT_TRUE(config.get("name", buf, sizeof(buf), ""));
+    TEST_ASSERT_EQUAL_STRING("before", buf);
+    TEST_ASSERT_EQUAL(1, config.getInt("interval", 0));
+    TEST_ASSERT_FALSE(config.get("extra", buf, sizeof(buf), ""));
+    TEST_ASSERT_FALSE(config.isDirty());
+}
+
+void test_config_rollback_keeps_earlier_notification(void) {
+    char buf[32];
+    ConfigManager config;
+    TEST_ASSERT_TRUE(config.begin());
+
+    // update() 전에 트랜잭션 시작 - 위치 변경 알림은 아직 대기 중
+    TEST_ASSERT_TRUE(config.set<Cfg::WeatherLocation>("Busan,KR"));
+    TEST_ASSERT_TRUE(config.beginTransaction());
+    TEST_ASSERT_TRUE(config.set<Cfg::WeatherLocation>("Jeju,KR"));
+    TEST_ASSERT_TRUE(config.set<Cfg::WeatherApiKey>("secret"));
+    TEST_ASSERT_TRUE(config.rollback());
+
+    config.update();
+    gEventBus.update();
+    TEST_ASSERT_EQUAL(1, configChangedCount);  // 위치만 (API 키 변경은 취소됨)
+    TEST_ASSERT_TRUE(config.get<Cfg::WeatherLocation>(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("Busan,KR", buf);
+}
+
+void test_config_commit_saves_once(void) {
+    ConfigManager config;
+    TEST_ASSERT_TRUE(config.begin());
+    TEST_ASSERT_TRUE(config.beginTransaction());
+    TEST_ASSERT_TRUE(config.setInt("interval", 5));
+    TEST_ASSERT_TRUE(config.setBool("flip", true));
+
+    // 트랜잭션 중에는 지연 저장 보류
+    mock_advance_millis(ConfigManager::SAVE_DELAY_MS);
+    config.update();
+    TEST_ASSERT_TRUE(config.isDirty());
+    TEST_ASSERT_TRUE(mock_fs_files.count(LITTLEFS_CONFIG_SLOT_A_FILE) == 0);
+
+    TEST_ASSERT_TRUE(config.commit());
+    TEST_ASSERT_FALSE(config.isDirty());
+
+    ConfigManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL(5, rebooted.getInt("interval", 0));
+    TEST_ASSERT_TRUE(rebooted.getBool("flip", false));
+}
+
+void test_config_commit_failed_save_still_publishes(void) {
+    char buf[32];
+    {
+        ConfigManager config;
+        TEST_ASSERT_TRUE(config.begin());
+        TEST_ASSERT_TRUE(config.beginTransaction());
+        TEST_ASSERT_TRUE(config.set<Cfg::WeatherLocation>("Busan,KR"));
+
+        // 저장 실패 - RAM 값은 확정되고 알림도 발행 (publish-before-persist)
+        mock_fs_write_budget = 0;
+        TEST_ASSERT_FALSE(config.commit());
+        TEST_ASSERT_FALSE(config.inTransaction());
+        TEST_ASSERT_TRUE(config.isDirty());
+        gEventBus.update();
+        TEST_ASSERT_EQUAL(1, configChangedCount);
+        TEST_ASSERT_TRUE(config.get<Cfg::WeatherLocation>(buf, sizeof(buf)));
+        TEST_ASSERT_EQUAL_STRING("Busan,KR", buf);
+
+        // update()가 저장 재시도 (알림은 다시 보내지 않음)
+        mock_fs_write_budget = -1;
+        mock_advance_millis(ConfigManager::SAVE_DELAY_MS);
+        config.update();
+        gEventBus.update();
+        TEST_ASSERT_FALSE(config.isDirty());
+        TEST_ASSERT_EQUAL(1, configChangedCount);
+    }
+
+    ConfigManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_TRUE(rebooted.get<Cfg::WeatherLocation>(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("Busan,KR", buf);
+}
+
+void test_config_debounced_save(void) {
+    ConfigManager config;
+    TEST_ASSERT_TRUE(config.begin());
+    TEST_ASSERT_TRUE(config.setInt("interval", 1));
+
+    mock_advance_millis(ConfigManager::SAVE_DELAY_MS - 1);
+    TEST_ASSERT_TRUE(config.setInt("interval", 2));  // 지연 다시 시작
+    mock_advance_millis(ConfigManager::SAVE_DELAY_MS - 1);
+    config.update();
+    TEST_ASSERT_TRUE(config.isDirty());
+    TEST_ASSERT_TRUE(mock_fs_files.count(LITTLEFS_CONFIG_SLOT_A_FILE) == 0);
+
+    mock_advance_millis(1);
+    config.update();
+    TEST_ASSERT_FALSE(config.isDirty());
+
+    // 연속된 변경이 슬롯 1개에 한 번만 기록됨
+    TEST_ASSERT_TRUE(mock_fs_files.count(LITTLEFS_CONFIG_SLOT_A_FILE) > 0);
+    TEST_ASSERT_TRUE(mock_fs_files.count(LITTLEFS_CONFIG_SLOT_B_FILE) == 0);
+}
+
+void test_config_schema_change_published(void) {
+    ConfigManager config;
+    TEST_ASSERT_TRUE(config.begin());
+    TEST_ASSERT_TRUE(config.set<Cfg::WeatherLocation>("Busan,KR"));
+    config.update();
+    gEventBus.update();
+    TEST_ASSERT_EQUAL(1, configChangedCount);
+
+    // 같은 값은 변경 아님
+    TEST_ASSERT_TRUE(config.set<Cfg::WeatherLocation>("Busan,KR"));
+    config.update();
+    gEventBus.update();
+    TEST_ASSERT_EQUAL(1, configChangedCount);
+}
+
+void test_config_schema_int_roundtrip(void) {
+    {
+        ConfigManager config;
+        TEST_ASSERT_TRUE(config.begin());
+        TEST_ASSERT_EQUAL_UINT32(600000, config.get<Cfg::WeatherInterval>());  // 스키마 기본값
+
+        TEST_ASSERT_TRUE(config.set<Cfg::WeatherInterval>(300000));  // 새 항목
+        TEST_ASSERT_EQUAL_UINT32(300000, config.get<Cfg::WeatherInterval>());
+        TEST_ASSERT_TRUE(config.set<Cfg::WeatherInterval>(120000));  // 기존 항목
+        TEST_ASSERT_EQUAL_UINT32(120000, config.get<Cfg::WeatherInterval>());
+        TEST_ASSERT_EQUAL(120000, config.getInt("weather_interval", 0));
+
+        // 파일에는 문자열이 아닌 숫자로 기록
+        StringPrint out;
+        TEST_ASSERT_TRUE(config.exportJson(out) > 0);
+        TEST_ASSERT_TRUE(out.text.find("\"weather_interval\":120000") != std::string::npos);
+        TEST_ASSERT_TRUE(config.save());
+    }
+
+    ConfigManager rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin());
+    TEST_ASSERT_EQUAL_UINT32(120000, rebooted.get<Cfg::WeatherInterval>());
+}
+
+void test_config_schema_int_from_string(void) {
+    ConfigManager config;
+    TEST_ASSERT_TRUE(config.begin());
+
+    // 이름 기반 문자열 설정도 스키마 타입(INT)으로 변환되어 저장
+    TEST_ASSERT_TRUE(config.set("weather_interval", "90000"));
+    TEST_ASSERT_EQUAL_UINT32(90000, config.get<Cfg::WeatherInterval>());
+
+    config.update();
+    gEventBus.update();
+    TEST_ASSERT_EQUAL(1, configChangedCount);
+
+    // 같은 값은 변경 아님
+    TEST_ASSERT_TRUE(config.set<Cfg::WeatherInterval>(90000));
+    config.update();
+    gEventBus.update();
+    TEST_ASSERT_EQUAL(1, configChangedCount);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_config_reload_after_reboot);
+    RUN_TEST(test_config_save_alternates_slots);
+    RUN_TEST(test_config_crc_failure_falls_back);
+    RUN_TEST(test_config_torn_save_keeps_previous_slot);
+    RUN_TEST(test_config_rollback_restores_values);
+    RUN_TEST(test_config_rollback_keeps_earlier_notification);
+    RUN_TEST(test_config_commit_saves_once);
+    RUN_TEST(test_config_commit_failed_save_still_publishes);
+    RUN_TEST(test_config_debounced_save);
+    RUN_TEST(test_config_schema_change_published);
+    RUN_TEST(test_config_schema_int_roundtrip);
+    RUN_TEST(test_config_schema_int_from_string);
+    return UNITY_END();
+}
+
+#endif // ARTHUR_NATIVE_TEST
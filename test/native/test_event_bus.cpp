@@ -0,0 +1,541 @@
+// @MX:NOTE: [TEST] EventBus 큐/정책/retained/ISR/타이머 테스트 (실제 event_bus.cpp 포함)
+// 실행: pio test -e native_test -f test_event_bus -v
+
+#ifdef ARTHUR_NATIVE_TEST
+
+#include <unity.h>
+#include "Arduino.h"
+#include "../../src/core/event_bus.cpp"
+
+// ==========================================
+// 테스트 코드
+// ==========================================
+
+// 테스트용 전역 변수
+static int callbackCallCount = 0;
+static EventType lastEventType = EVENT_TYPE_COUNT;
+static const void* lastUserData = nullptr;
+
+// 테스트용 콜백
+void testCallback(const Event& event, void* userData) {
+    callbackCallCount++;
+    lastEventType = event.type;
+    lastUserData = userData;
+}
+
+void setUp(void) {
+    mock_reset_millis();
+    callbackCallCount = 0;
+    lastEventType = EVENT_TYPE_COUNT;
+    lastUserData = nullptr;
+}
+
+void tearDown(void) {}
+
+// 테스트 케이스
+void test_event_bus_initialization(void) {
+    EventBus bus;
+    bus.begin();
+    TEST_ASSERT_TRUE(bus.update() >= 0);
+}
+
+void test_event_bus_subscribe_publish(void) {
+    EventBus bus;
+    bus.begin();
+
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+
+    Event e;
+    e.type = WIFI_CONNECTED;
+    bus.publish(e);
+    bus.update();
+
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+    TEST_ASSERT_EQUAL_INT(WIFI_CONNECTED, lastEventType);
+}
+
+void test_event_bus_multiple_subscribers(void) {
+    EventBus bus;
+    bus.begin();
+
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+    bus.subscribe(WIFI_CONNECTED, testCallback, (void*)1);
+    bus.subscribe(WIFI_CONNECTED, testCallback, (void*)2);
+
+    Event e;
+    e.type = WIFI_CONNECTED;
+    bus.publish(e);
+    bus.update();
+
+    TEST_ASSERT_EQUAL_INT(3, callbackCallCount);
+}
+
+void test_event_bus_queue_overflow(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+
+    // 예약 슬롯 없이 순수 큐 용량 확인
+    for (int type = 0; type < EVENT_TYPE_COUNT; type++) {
+        bus.setPolicy((EventType)type, POLICY_DROP_NEWEST);
+    }
+
+    Event e;
+    e.type = WIFI_CONNECTED;
+
+    // 큐 크기(16)보다 많은 이벤트 발행
+    for (int i = 0; i < 20; i++) {
+        bool result = bus.publish(e);
+        if (i < 16) {
+            TEST_ASSERT_TRUE(result);
+        } else {
+            TEST_ASSERT_FALSE(result);
+        }
+    }
+}
+
+void test_event_bus_max_subscribers(void) {
+    EventBus bus;
+    bus.begin();
+
+    // MAX_SUBSCRIBERS(4)만큼 구독 성공
+    TEST_ASSERT_TRUE(bus.subscribe(WIFI_CONNECTED, testCallback, nullptr));
+    TEST_ASSERT_TRUE(bus.subscribe(WIFI_CONNECTED, testCallback, (void*)1));
+    TEST_ASSERT_TRUE(bus.subscribe(WIFI_CONNECTED, testCallback, (void*)2));
+    TEST_ASSERT_TRUE(bus.subscribe(WIFI_CONNECTED, testCallback, (void*)3));
+
+    // 5번째 구독은 실패해야 함
+    TEST_ASSERT_FALSE(bus.subscribe(WIFI_CONNECTED, testCallback, (void*)4));
+}
+
+void test_event_bus_clear(void) {
+    EventBus bus;
+    bus.begin();
+
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+    bus.clear();
+
+    Event e;
+    e.type = WIFI_CONNECTED;
+    bus.publish(e);
+    bus.update();
+
+    // clear() 후에는 콜백이 호출되지 않아야 함
+    TEST_ASSERT_EQUAL_INT(0, callbackCallCount);
+}
+
+void test_event_bus_unsubscribe(void) {
+    EventBus bus;
+    bus.begin();
+
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+    bus.unsubscribe(WIFI_CONNECTED, testCallback);
+
+    Event e;
+    e.type = WIFI_CONNECTED;
+    bus.publish(e);
+    bus.update();
+
+    TEST_ASSERT_EQUAL_INT(0, callbackCallCount);
+}
+
+void test_event_bus_user_data(void) {
+    EventBus bus;
+    bus.begin();
+
+    int userData = 42;
+    bus.subscribe(WIFI_CONNECTED, testCallback, &userData);
+
+    Event e;
+    e.type = WIFI_CONNECTED;
+    bus.publish(e);
+    bus.update();
+
+    TEST_ASSERT_EQUAL_PTR(&userData, lastUserData);
+}
+
+void test_event_bus_invalid_type(void) {
+    EventBus bus;
+    bus.begin();
+
+    // 잘못된 타입으로 구독 시도
+    TEST_ASSERT_FALSE(bus.subscribe((EventType)-1, testCallback, nullptr));
+    TEST_ASSERT_FALSE(bus.subscribe(EVENT_TYPE_COUNT, testCallback, nullptr));
+
+    // 잘못된 타입으로 발행 시도
+    Event e;
+    e.type = (EventType)-1;
+    TEST_ASSERT_FALSE(bus.publish(e));
+}
+
+// payload가 발행 시점에 복사되어 원본 수명과 무관한지 확인
+struct TestPayload {
+    float value;
+    uint32_t seq;
+};
+
+static TestPayload lastPayload;
+static bool lastPayloadValid = false;
+
+void payloadCallback(const Event& event, void* userData) {
+    const TestPayload* p = event.as<TestPayload>();
+    lastPayloadValid = (p != nullptr);
+    if (p != nullptr) {
+        lastPayload = *p;
+    }
+}
+
+void test_event_bus_inline_payload(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(SENSOR_UPDATED, payloadCallback, nullptr);
+
+    {
+        TestPayload data = { 21.5f, 7 };
+        TEST_ASSERT_TRUE(bus.publish(SENSOR_UPDATED, data));
+        data.value = -1.0f;  // 발행 후 원본 변경은 큐에 영향 없음
+    }
+    bus.update();
+
+    TEST_ASSERT_TRUE(lastPayloadValid);
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, lastPayload.value);
+    TEST_ASSERT_EQUAL_UINT32(7, lastPayload.seq);
+
+    // payload 없는 이벤트는 as<T>()가 nullptr
+    bus.publish(SENSOR_UPDATED);
+    bus.update();
+    TEST_ASSERT_FALSE(lastPayloadValid);
+}
+
+// 상태형 이벤트는 대기 중인 슬롯 하나를 최신 값으로 갱신
+void test_event_bus_coalesce(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(SENSOR_UPDATED, payloadCallback, nullptr);
+    bus.subscribe(SENSOR_UPDATED, testCallback, nullptr);
+
+    for (uint32_t i = 0; i < 40; i++) {
+        TestPayload data = { 20.0f, i };
+        TEST_ASSERT_TRUE(bus.publish(SENSOR_UPDATED, data));
+    }
+    TEST_ASSERT_EQUAL_UINT32(39, bus.coalesceCount());
+    TEST_ASSERT_EQUAL_UINT32(0, bus.dropCount());
+
+    TEST_ASSERT_EQUAL_INT(1, bus.update());
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+    TEST_ASSERT_EQUAL_UINT32(39, lastPayload.seq);
+}
+
+// 포화 시 같은 타입의 가장 오래된 이벤트를 버림
+void test_event_bus_drop_oldest(void) {
+    EventBus bus;
+    bus.begin();
+    bus.setPolicy(WIFI_CONNECTED, POLICY_DROP_NEWEST);
+    bus.setPolicy(WIFI_DISCONNECTED, POLICY_DROP_NEWEST);
+    bus.setPolicy(CONFIG_CHANGED, POLICY_DROP_OLDEST);
+    bus.subscribe(CONFIG_CHANGED, payloadCallback, nullptr);
+
+    for (uint32_t i = 0; i < 20; i++) {
+        TestPayload data = { 0.0f, i };
+        TEST_ASSERT_TRUE(bus.publish(CONFIG_CHANGED, data));
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, bus.dropCount());
+
+    // 첫 전파는 남아 있는 가장 오래된 이벤트(4번)
+    TEST_ASSERT_EQUAL_INT(16, bus.update());
+    TEST_ASSERT_EQUAL_UINT32(19, lastPayload.seq);
+}
+
+// 센서 버스트가 큐를 채워도 WiFi 이벤트는 유실되지 않음
+void test_event_bus_never_drop(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+
+    // 합치지 않는 타입으로 공유 슬롯을 모두 채움 (16 - 예약 2 = 14)
+    int accepted = 0;
+    for (int i = 0; i < 20; i++) {
+        if (bus.publish(CONFIG_CHANGED)) {
+            accepted++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(14, accepted);
+    TEST_ASSERT_EQUAL_UINT32(6, bus.dropCount());
+
+    // 예약 슬롯 사용, 두 번째는 가장 오래된 CONFIG_CHANGED를 밀어냄
+    TEST_ASSERT_TRUE(bus.publish(WIFI_CONNECTED));
+    TEST_ASSERT_TRUE(bus.publish(WIFI_CONNECTED));
+    TEST_ASSERT_EQUAL_UINT32(7, bus.dropCount());
+
+    // 13 + 2, WIFI_DISCONNECTED 예약 슬롯은 비어 있음
+    TEST_ASSERT_EQUAL_INT(15, bus.update());
+    TEST_ASSERT_EQUAL_INT(2, callbackCallCount);
+}
+
+// 늦게 구독해도 마지막 상태를 다음 update()에서 받음
+void test_event_bus_retained(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(WEATHER_UPDATED, testCallback, nullptr);
+
+    TestPayload data = { 18.0f, 3 };
+    bus.publish(WEATHER_UPDATED, data);
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+    TEST_ASSERT_TRUE(bus.retained(WEATHER_UPDATED) != nullptr);
+    TEST_ASSERT_TRUE(bus.retained(SENSOR_UPDATED) == nullptr);
+
+    // 늦은 구독자만 받고 기존 구독자는 다시 받지 않음
+    lastPayloadValid = false;
+    bus.subscribe(WEATHER_UPDATED, payloadCallback, nullptr, true);
+    TEST_ASSERT_EQUAL_INT(1, bus.update());
+    TEST_ASSERT_TRUE(lastPayloadValid);
+    TEST_ASSERT_EQUAL_UINT32(3, lastPayload.seq);
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+
+    // 한 번만 전달
+    lastPayloadValid = false;
+    TEST_ASSERT_EQUAL_INT(0, bus.update());
+    TEST_ASSERT_FALSE(lastPayloadValid);
+
+    // deliverRetained=false면 전달 안 함
+    bus.subscribe(WEATHER_UPDATED, testCallback, (void*)1);
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+}
+
+static uint32_t lastButtonValue = 0;
+
+void buttonCallback(const Event& event, void* userData) {
+    callbackCallCount++;
+    const uint32_t* value = event.as<uint32_t>();
+    lastButtonValue = (value != nullptr) ? *value : 0;
+}
+
+// ISR 링은 update()에서 일반 전파로 넘어감, 링 크기-1개까지 보관
+void test_event_bus_publish_from_isr(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(BUTTON_PRESSED, buttonCallback, nullptr);
+
+    for (uint32_t i = 1; i <= 10; i++) {
+        bool result = bus.publishFromISR(BUTTON_PRESSED, i);
+        TEST_ASSERT_EQUAL_INT(i <= 7 ? 1 : 0, result ? 1 : 0);
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, bus.isrDropCount());
+    TEST_ASSERT_FALSE(bus.publishFromISR(EVENT_TYPE_COUNT, 0));
+
+    TEST_ASSERT_EQUAL_INT(7, bus.update());
+    TEST_ASSERT_EQUAL_INT(7, callbackCallCount);
+    TEST_ASSERT_EQUAL_UINT32(7, lastButtonValue);
+
+    // 링이 비었으므로 다시 발행 가능
+    TEST_ASSERT_TRUE(bus.publishFromISR(BUTTON_PRESSED, 42));
+    TEST_ASSERT_EQUAL_INT(1, bus.update());
+    TEST_ASSERT_EQUAL_UINT32(42, lastButtonValue);
+}
+
+// 콜백마다 같은 타입을 다시 발행하는 폭주 구독자 (userData로 버스 전달)
+void republishCallback(const Event& event, void* userData) {
+    callbackCallCount++;
+    mock_micros_counter += 300;  // 느린 구독자
+    static_cast<EventBus*>(userData)->publish(event.type);
+}
+
+void test_event_bus_update_budget(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(CONFIG_CHANGED, republishCallback, &bus);
+
+    // 콜백이 발행한 이벤트는 이번 호출에서 처리하지 않음
+    bus.publish(CONFIG_CHANGED);
+    TEST_ASSERT_EQUAL_INT(1, bus.update());
+    TEST_ASSERT_EQUAL_INT(1, bus.queuedCount());
+
+    // 개수 예산
+    bus.clear();
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+    for (int i = 0; i < 5; i++) {
+        bus.publish(WIFI_CONNECTED);
+    }
+    TEST_ASSERT_EQUAL_INT(2, bus.update(2));
+    TEST_ASSERT_EQUAL_INT(3, bus.queuedCount());
+
+    // 시간 예산 (이벤트당 300us, 예산 500us -> 2개)
+    bus.clear();
+    callbackCallCount = 0;
+    bus.subscribe(CONFIG_CHANGED, republishCallback, &bus);
+    for (int i = 0; i < 4; i++) {
+        bus.publish(CONFIG_CHANGED);
+    }
+    TEST_ASSERT_EQUAL_INT(2, bus.update(0, 500));
+    TEST_ASSERT_EQUAL_INT(2, callbackCallCount);
+    TEST_ASSERT_EQUAL_INT(4, bus.queuedCount());
+}
+
+static int nestedUpdateResult = -1;
+
+void nestedUpdateCallback(const Event& event, void* userData) {
+    callbackCallCount++;
+    nestedUpdateResult = static_cast<EventBus*>(userData)->update();
+}
+
+void test_event_bus_update_reentrancy(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(WIFI_CONNECTED, nestedUpdateCallback, &bus);
+
+    bus.publish(WIFI_CONNECTED);
+    bus.publish(WIFI_CONNECTED);
+    TEST_ASSERT_EQUAL_INT(2, bus.update());
+    TEST_ASSERT_EQUAL_INT(2, callbackCallCount);
+    TEST_ASSERT_EQUAL_INT(0, nestedUpdateResult);
+    TEST_ASSERT_EQUAL_INT(0, bus.queuedCount());
+}
+
+void test_event_bus_publish_after(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, bus.nextTimerDelay());
+    int id = bus.publishAfter(WIFI_CONNECTED, 1000);
+    TEST_ASSERT_TRUE(id != EVENT_TIMER_NONE);
+    TEST_ASSERT_EQUAL_UINT32(1000, bus.nextTimerDelay());
+
+    // 일찍 발행되지 않음
+    mock_advance_millis(999);
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(0, callbackCallCount);
+    TEST_ASSERT_EQUAL_UINT32(1, bus.nextTimerDelay());
+
+    mock_advance_millis(1);
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+
+    // 한 번만 발행, 슬롯 반환
+    mock_advance_millis(5000);
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+    TEST_ASSERT_FALSE(bus.cancelTimer(id));
+
+    // 취소하면 발행 안 함
+    id = bus.publishAfter(WIFI_CONNECTED, 100);
+    TEST_ASSERT_TRUE(bus.cancelTimer(id));
+    mock_advance_millis(200);
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+
+    // 슬롯이 다 차면 실패
+    for (int i = 0; i < EVENT_TIMER_COUNT; i++) {
+        TEST_ASSERT_TRUE(bus.publishAfter(WIFI_CONNECTED, 100) != EVENT_TIMER_NONE);
+    }
+    TEST_ASSERT_EQUAL_INT(EVENT_TIMER_NONE, bus.publishAfter(WIFI_CONNECTED, 100));
+}
+
+// millis() 롤오버를 지나도 주기 유지, 밀린 주기는 한 번만 발행
+void test_event_bus_publish_every_rollover(void) {
+    mock_millis_counter = 0xFFFFFFFFUL - 1500;
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(SENSOR_UPDATED, payloadCallback, nullptr);
+    bus.subscribe(SENSOR_UPDATED, testCallback, nullptr);
+
+    Event e;
+    e.type = SENSOR_UPDATED;
+    TestPayload data = { 1.0f, 9 };
+    memcpy(e.payload, &data, sizeof(data));
+    e.size = sizeof(data);
+    bus.publishEvery(e, 1000);
+
+    for (int i = 0; i < 5; i++) {
+        mock_advance_millis(1000);
+        bus.update();
+    }
+    TEST_ASSERT_EQUAL_INT(5, callbackCallCount);
+    TEST_ASSERT_EQUAL_UINT32(9, lastPayload.seq);
+
+    // 루프가 10초 멈춤 -> 한 번 발행 후 다음 주기로 맞춤
+    mock_advance_millis(10000);
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(6, callbackCallCount);
+    TEST_ASSERT_EQUAL_UINT32(1000, bus.nextTimerDelay());
+}
+
+// 틱 중간에 등록해도 첫 발행만 늦춰지고 이후 주기는 periodMs 그대로
+void test_event_bus_publish_every_mid_tick(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+    bus.update();
+
+    mock_advance_millis(7);  // 틱에 반영되지 않은 7ms
+    bus.publishEvery(WIFI_CONNECTED, 100);
+
+    // 첫 발행: 등록 후 100ms 이상 (틱 경계로 올림)
+    mock_advance_millis(99);
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(0, callbackCallCount);
+    mock_advance_millis(4);  // 110ms 틱
+    bus.update();
+    TEST_ASSERT_EQUAL_INT(1, callbackCallCount);
+    TEST_ASSERT_EQUAL_UINT32(100, bus.nextTimerDelay());
+
+    // 이후 주기는 100ms (110ms가 아님)
+    for (int i = 2; i <= 10; i++) {
+        mock_advance_millis(100);
+        bus.update();
+        TEST_ASSERT_EQUAL_INT(i, callbackCallCount);
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, bus.nextTimerDelay());
+}
+
+// UINT32_MAX 근처 지연도 올림 계산이 넘치지 않음 (바로 발행되지 않음)
+void test_event_bus_publish_after_max_delay(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(WIFI_CONNECTED, testCallback, nullptr);
+    bus.update();
+
+    mock_advance_millis(7);  // 틱에 반영되지 않은 경과 시간도 더해짐
+    TEST_ASSERT_TRUE(bus.publishAfter(WIFI_CONNECTED, UINT32_MAX) != EVENT_TIMER_NONE);
+    TEST_ASSERT_TRUE(bus.publishEvery(WIFI_CONNECTED, UINT32_MAX - 5) != EVENT_TIMER_NONE);
+    TEST_ASSERT_TRUE(bus.nextTimerDelay() > 0xFFFF0000UL);
+    TEST_ASSERT_TRUE(bus.nextTimerDelay() != UINT32_MAX);  // 타이머 없음과 구분
+
+    for (int i = 0; i < 10; i++) {
+        mock_advance_millis(1000);
+        bus.update();
+    }
+    TEST_ASSERT_EQUAL_INT(0, callbackCallCount);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_event_bus_initialization);
+    RUN_TEST(test_event_bus_subscribe_publish);
+    RUN_TEST(test_event_bus_multiple_subscribers);
+    RUN_TEST(test_event_bus_queue_overflow);
+    RUN_TEST(test_event_bus_max_subscribers);
+    RUN_TEST(test_event_bus_clear);
+    RUN_TEST(test_event_bus_unsubscribe);
+    RUN_TEST(test_event_bus_user_data);
+    RUN_TEST(test_event_bus_invalid_type);
+    RUN_TEST(test_event_bus_inline_payload);
+    RUN_TEST(test_event_bus_coalesce);
+    RUN_TEST(test_event_bus_drop_oldest);
+    RUN_TEST(test_event_bus_never_drop);
+    RUN_TEST(test_event_bus_retained);
+    RUN_TEST(test_event_bus_publish_from_isr);
+    RUN_TEST(test_event_bus_update_budget);
+    RUN_TEST(test_event_bus_update_reentrancy);
+    RUN_TEST(test_event_bus_publish_after);
+    RUN_TEST(test_event_bus_publish_every_rollover);
+    RUN_TEST(test_event_bus_publish_every_mid_tick);
+    RUN_TEST(test_event_bus_publish_after_max_delay);
+
+    return UNITY_END();
+}
+
+#endif // ARTHUR_NATIVE_TEST
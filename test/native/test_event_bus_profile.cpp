@@ -0,0 +1,128 @@
+// @MX:NOTE: [TEST] EventBus 프로파일링 통계 테스트 (EVENT_BUS_PROFILE=1로 실제 event_bus.cpp 포함)
+// 콜백 실행 시간은 mock micros로 만들어 냄 (ESP.getCycleCount() = micros * 160)
+// 실행: pio test -e native_test -f test_event_bus_profile -v
+
+#ifdef ARTHUR_NATIVE_TEST
+
+#define EVENT_BUS_PROFILE 1
+
+#include <unity.h>
+#include "Arduino.h"
+#include "../../src/core/event_bus.cpp"
+
+class StringPrint : public Print {
+public:
+    std::string text;
+    size_t write(uint8_t c) override { text += (char)c; return 1; }
+    using Print::write;
+};
+
+static int fastCalls = 0;
+
+static void fastCallback(const Event& event, void* userData) {
+    fastCalls++;
+}
+
+// 100us = 16000 사이클 -> 4K 이상 16K 미만 버킷 (2)
+static void slowCallback(const Event& event, void* userData) {
+    delayMicroseconds(100);
+}
+
+void setUp(void) {
+    mock_reset_millis();
+    fastCalls = 0;
+}
+
+void tearDown(void) {}
+
+void test_profile_type_stats(void) {
+    EventBus bus;
+    bus.begin();
+    bus.setPolicy(SENSOR_UPDATED, POLICY_COALESCE);
+    bus.subscribe(SENSOR_UPDATED, fastCallback, nullptr);
+
+    // 3번 발행 -> 대기 슬롯 하나로 합쳐짐
+    uint32_t value = 1;
+    TEST_ASSERT_TRUE(bus.publish(SENSOR_UPDATED, value));
+    TEST_ASSERT_TRUE(bus.publish(SENSOR_UPDATED, value));
+    TEST_ASSERT_TRUE(bus.publish(SENSOR_UPDATED, value));
+    TEST_ASSERT_TRUE(bus.publish(WIFI_CONNECTED));
+
+    delayMicroseconds(500);  // 큐 체류 시간
+    TEST_ASSERT_EQUAL_INT(2, bus.update());
+    TEST_ASSERT_EQUAL_INT(1, fastCalls);
+
+    EventBus::TypeStats stats = bus.getTypeStats(SENSOR_UPDATED);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.published);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.coalesced);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.dispatched);
+    TEST_ASSERT_EQUAL_UINT32(500, stats.residenceMaxUs);
+    TEST_ASSERT_EQUAL_UINT32(500, stats.residenceAvgUs);
+    TEST_ASSERT_EQUAL_UINT8(1, stats.pendingHighWater);
+    TEST_ASSERT_EQUAL_UINT8(2, bus.queueHighWater());
+
+    // 잘못된 타입은 빈 통계
+    stats = bus.getTypeStats(EVENT_TYPE_COUNT);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.published);
+}
+
+void test_profile_callback_histogram(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(TIME_SYNCED, fastCallback, nullptr);   // 슬롯 0
+    bus.subscribe(TIME_SYNCED, slowCallback, nullptr);   // 슬롯 1
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(bus.publish(TIME_SYNCED));
+        bus.update();
+    }
+
+    EventBus::CallbackStats fast = bus.getCallbackStats(TIME_SYNCED, 0);
+    TEST_ASSERT_EQUAL_UINT32(3, fast.calls);
+    TEST_ASSERT_EQUAL_UINT32(0, fast.maxCycles);
+    TEST_ASSERT_EQUAL_UINT16(3, fast.histogram[0]);
+
+    EventBus::CallbackStats slow = bus.getCallbackStats(TIME_SYNCED, 1);
+    TEST_ASSERT_EQUAL_UINT32(3, slow.calls);
+    TEST_ASSERT_EQUAL_UINT32(16000, slow.maxCycles);
+    TEST_ASSERT_EQUAL_UINT16(0, slow.histogram[0]);
+    TEST_ASSERT_EQUAL_UINT16(3, slow.histogram[2]);
+
+    // retained 재전달도 같은 경로로 집계
+    bus.subscribe(TIME_SYNCED, fastCallback, (void*)1, true);   // 슬롯 2
+    bus.update();
+    TEST_ASSERT_EQUAL_UINT32(1, bus.getCallbackStats(TIME_SYNCED, 2).calls);
+    TEST_ASSERT_EQUAL_UINT32(3, bus.getCallbackStats(TIME_SYNCED, 0).calls);
+}
+
+void test_profile_print_and_reset(void) {
+    EventBus bus;
+    bus.begin();
+    bus.subscribe(WEATHER_UPDATED, slowCallback, nullptr);
+    TEST_ASSERT_TRUE(bus.publish(WEATHER_UPDATED));
+    bus.update();
+
+    StringPrint out;
+    bus.printStats(out);
+    TEST_ASSERT_TRUE(out.text.find("queue high-water 1/") != std::string::npos);
+    TEST_ASSERT_TRUE(out.text.find("type 4: pub 1") != std::string::npos);
+    TEST_ASSERT_TRUE(out.text.find("sub 0: calls 1 max 100 us") != std::string::npos);
+
+    bus.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, bus.getTypeStats(WEATHER_UPDATED).published);
+    TEST_ASSERT_EQUAL_UINT32(0, bus.getCallbackStats(WEATHER_UPDATED, 0).calls);
+    TEST_ASSERT_EQUAL_UINT8(0, bus.queueHighWater());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_profile_type_stats);
+    RUN_TEST(test_profile_callback_histogram);
+    RUN_TEST(test_profile_print_and_reset);
+
+    return UNITY_END();
+}
+
+#endif // ARTHUR_NATIVE_TEST
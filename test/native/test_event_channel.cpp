@@ -0,0 +1,286 @@
+// @MX:NOTE: [TEST] Channel<T> 팬아웃/구독 취소/retained 전달/필터 테스트 (실제 EventBus 사용)
+// 실행: pio test -e native_test -f test_event_channel -v
+
+#ifdef ARTHUR_NATIVE_TEST
+
+#include <unity.h>
+#include "Arduino.h"
+#include "../../src/core/event_bus.cpp"
+#include "../../src/core/event_channel.h"
+
+struct Reading {
+    float value;
+    uint8_t source;
+    bool valid;
+};
+EVENT_CHANNEL(Reading, SENSOR_UPDATED, 3);
+
+struct Recorder {
+    int calls;
+    float last;
+};
+static Recorder recorders[3];
+
+// 구독 취소가 콜백 기준이라 구독자마다 다른 함수
+template <int N>
+static void record(const Reading& value, void* userData) {
+    recorders[N].calls++;
+    recorders[N].last = value.value;
+}
+
+typedef Channel<Reading>::Filter Filter;
+
+// 첫 이벤트에서 스스로 구독 취소
+static void recordOnce(const Reading& value, void* userData) {
+    recorders[0].calls++;
+    Channel<Reading>::unsubscribe(recordOnce);
+}
+
+static void publishReading(float value, uint8_t source = 0, bool valid = true) {
+    Reading reading = { value, source, valid };
+    TEST_ASSERT_TRUE(Channel<Reading>::publish(reading));
+    gEventBus.update();
+}
+
+void setUp(void) {
+    mock_reset_millis();
+    gEventBus.clear();
+    gEventBus.begin();
+    memset(recorders, 0, sizeof(recorders));
+}
+
+void tearDown(void) {
+    // 채널 구독자 배열은 정적 - 다음 테스트 전에 비움
+    Channel<Reading>::unsubscribe(record<0>);
+    Channel<Reading>::unsubscribe(record<1>);
+    Channel<Reading>::unsubscribe(record<2>);
+}
+
+void test_channel_fan_out(void) {
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<1>));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<2>));
+    TEST_ASSERT_FALSE(Channel<Reading>::subscribe(record<0>));  // maxSubscribers 초과
+    TEST_ASSERT_EQUAL(3, Channel<Reading>::subscriberCount());
+
+    publishReading(21.5f);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, recorders[i].calls);
+        TEST_ASSERT_EQUAL_FLOAT(21.5f, recorders[i].last);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, Channel<Reading>::retained()->value);
+
+    // 마지막 구독자가 빠지면 EventBus 구독도 해제
+    Channel<Reading>::unsubscribe(record<0>);
+    Channel<Reading>::unsubscribe(record<1>);
+    Channel<Reading>::unsubscribe(record<2>);
+    TEST_ASSERT_EQUAL(0, Channel<Reading>::subscriberCount());
+    publishReading(22.0f);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+}
+
+void test_channel_retained_only_to_requester(void) {
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>));
+    publishReading(10.0f);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+
+    // 늦은 구독자만 보관 값을 받음 (기존 구독자에게 다시 보내지 않음)
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<1>, nullptr, true));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<2>));
+    gEventBus.update();
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[1].calls);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, recorders[1].last);
+    TEST_ASSERT_EQUAL_INT(0, recorders[2].calls);
+
+    // 한 번만 전달
+    gEventBus.update();
+    TEST_ASSERT_EQUAL_INT(1, recorders[1].calls);
+
+    // 이후 새 값은 모두에게
+    publishReading(11.0f);
+    TEST_ASSERT_EQUAL_INT(2, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(2, recorders[1].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[2].calls);
+}
+
+void test_channel_unsubscribe_moves_retained_bit(void) {
+    publishReading(5.0f);  // 보관 값 준비 (구독자 없음)
+
+    // [0]=record<0>, [1]=record<1> (retained 대기), [2]=record<2> (retained 대기)
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<1>, nullptr, true));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<2>, nullptr, true));
+
+    // record<2>가 [1]로 옮겨지면서 대기 비트도 따라감
+    Channel<Reading>::unsubscribe(record<1>);
+    TEST_ASSERT_EQUAL(2, Channel<Reading>::subscriberCount());
+    gEventBus.update();
+    TEST_ASSERT_EQUAL_INT(0, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(0, recorders[1].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[2].calls);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, recorders[2].last);
+}
+
+void test_channel_unsubscribe_clears_retained_bit(void) {
+    publishReading(5.0f);
+
+    // [1]만 retained 대기, 빠진 자리로 옮겨진 record<2>는 받지 않아야 함
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<1>, nullptr, true));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<2>));
+
+    Channel<Reading>::unsubscribe(record<1>);
+    gEventBus.update();
+    TEST_ASSERT_EQUAL_INT(0, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(0, recorders[1].calls);
+    TEST_ASSERT_EQUAL_INT(0, recorders[2].calls);
+
+    publishReading(6.0f);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[2].calls);
+}
+
+void test_channel_filter_when_true(void) {
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>, nullptr, false,
+                                                 Filter().whenTrue(&Reading::valid)));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<1>));
+
+    publishReading(1.0f, 0, false);
+    TEST_ASSERT_EQUAL_INT(0, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[1].calls);
+
+    publishReading(2.0f, 0, true);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, recorders[0].last);
+}
+
+void test_channel_filter_min_delta(void) {
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>, nullptr, false,
+                                                 Filter().minDelta(&Reading::value, 0.5f)));
+
+    publishReading(20.0f);  // 첫 값은 항상 통과
+    publishReading(20.3f);  // 기준 20.0 대비 0.3
+    publishReading(19.8f);  // 기준 20.0 대비 0.2 (음수 방향)
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+
+    publishReading(20.6f);  // 기준 20.0 대비 0.6 -> 통과, 기준 갱신
+    TEST_ASSERT_EQUAL_INT(2, recorders[0].calls);
+    publishReading(20.9f);  // 새 기준 20.6 대비 0.3
+    TEST_ASSERT_EQUAL_INT(2, recorders[0].calls);
+    publishReading(20.0f);  // 새 기준 대비 -0.6
+    TEST_ASSERT_EQUAL_INT(3, recorders[0].calls);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, recorders[0].last);
+}
+
+void test_channel_filter_from_sources(void) {
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>, nullptr, false,
+        Filter().fromSources(&Reading::source, (1UL << 1) | (1UL << 3))));
+
+    publishReading(1.0f, 0);
+    publishReading(2.0f, 1);
+    publishReading(3.0f, 2);
+    publishReading(4.0f, 3);
+    publishReading(5.0f, 40);  // 비트 범위 밖
+    TEST_ASSERT_EQUAL_INT(2, recorders[0].calls);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, recorders[0].last);
+}
+
+void test_channel_filter_combined(void) {
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>, nullptr, false,
+        Filter().whenTrue(&Reading::valid).minDelta(&Reading::value, 1.0f)));
+
+    publishReading(10.0f);
+    // 걸러진 값(무효)은 델타 기준을 바꾸지 않음
+    publishReading(50.0f, 0, false);
+    publishReading(10.5f);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+    publishReading(11.0f);
+    TEST_ASSERT_EQUAL_INT(2, recorders[0].calls);
+}
+
+void test_channel_filter_delta_per_subscriber(void) {
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>, nullptr, false,
+                                                 Filter().minDelta(&Reading::value, 1.0f)));
+    publishReading(10.0f);
+    publishReading(10.6f);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+
+    // 늦은 구독자는 자기 기준으로 시작 (retained 10.6이 첫 값)
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<1>, nullptr, true,
+                                                 Filter().minDelta(&Reading::value, 1.0f)));
+    gEventBus.update();
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[1].calls);
+    TEST_ASSERT_EQUAL_FLOAT(10.6f, recorders[1].last);
+
+    // 11.2: record<0> 기준 10.0 대비 1.2 -> 통과, record<1> 기준 10.6 대비 0.6 -> 걸러짐
+    publishReading(11.2f);
+    TEST_ASSERT_EQUAL_INT(2, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[1].calls);
+}
+
+void test_channel_filter_retained(void) {
+    publishReading(7.0f, 0, false);  // 보관 값이 무효
+
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>, nullptr, true,
+                                                 Filter().whenTrue(&Reading::valid)));
+    gEventBus.update();
+    TEST_ASSERT_EQUAL_INT(0, recorders[0].calls);
+}
+
+void test_channel_unsubscribe_during_dispatch(void) {
+    // [0]=recordOnce, [1]=record<1>, [2]=record<2> (델타 필터)
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(recordOnce));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<1>));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<2>, nullptr, false,
+                                                 Filter().minDelta(&Reading::value, 1.0f)));
+
+    // 전파 중 구독 취소 - 뒤쪽 구독자도 이번 이벤트를 받아야 함
+    publishReading(10.0f);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[1].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[2].calls);
+    TEST_ASSERT_EQUAL(2, Channel<Reading>::subscriberCount());
+
+    // 옮겨진 구독자의 델타 기준은 10.0 그대로
+    publishReading(10.5f);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(2, recorders[1].calls);
+    TEST_ASSERT_EQUAL_INT(1, recorders[2].calls);
+    publishReading(11.0f);
+    TEST_ASSERT_EQUAL_INT(2, recorders[2].calls);
+}
+
+void test_channel_retained_flag(void) {
+    publishReading(3.0f);
+    const Event* stored = gEventBus.retained(SENSOR_UPDATED);
+    TEST_ASSERT_NOT_NULL(stored);
+    TEST_ASSERT_TRUE(stored->isRetained());
+
+    // 보관 값과 같은 내용이 다시 발행되어도 일반 전파는 모든 구독자에게
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<0>));
+    TEST_ASSERT_TRUE(Channel<Reading>::subscribe(record<1>, nullptr, true));
+    publishReading(3.0f);
+    TEST_ASSERT_EQUAL_INT(1, recorders[0].calls);
+    TEST_ASSERT_EQUAL_INT(2, recorders[1].calls);  // retained 1회 + 일반 1회
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_channel_fan_out);
+    RUN_TEST(test_channel_retained_only_to_requester);
+    RUN_TEST(test_channel_unsubscribe_moves_retained_bit);
+    RUN_TEST(test_channel_unsubscribe_clears_retained_bit);
+    RUN_TEST(test_channel_filter_when_true);
+    RUN_TEST(test_channel_filter_min_delta);
+    RUN_TEST(test_channel_filter_from_sources);
+    RUN_TEST(test_channel_filter_combined);
+    RUN_TEST(test_channel_filter_delta_per_subscriber);
+    RUN_TEST(test_channel_filter_retained);
+    RUN_TEST(test_channel_unsubscribe_during_dispatch);
+    RUN_TEST(test_channel_retained_flag);
+    return UNITY_END();
+}
+
+#endif // ARTHUR_NATIVE_TEST